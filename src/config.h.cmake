@@ -59,6 +59,9 @@
 /* Define if JACK MIDI support is enabled. */
 #cmakedefine CONFIG_JACK_MIDI @CONFIG_JACK_MIDI@
 
+/* Define if JACK MIDI 2.0 (UMP) support is enabled. */
+#cmakedefine CONFIG_JACK_MIDI2 @CONFIG_JACK_MIDI2@
+
 /* Define if LV2 plug-in build is enabled. */
 #cmakedefine CONFIG_LV2 @CONFIG_LV2@
 
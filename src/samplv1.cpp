@@ -33,6 +33,9 @@
 
 #include "samplv1_fx.h"
 #include "samplv1_reverb.h"
+#include "samplv1_convolver.h"
+
+#include "samplv1_pool.h"
 
 #include "samplv1_pshifter.h"
 
@@ -42,6 +45,9 @@
 #include "samplv1_tuning.h"
 
 #include "samplv1_sched.h"
+#include "samplv1_ftz.h"
+
+#include <QMutex>
 
 
 #ifdef CONFIG_DEBUG_0
@@ -49,6 +55,8 @@
 #endif
 
 #include <cstring>
+#include <new>
+#include <atomic>
 
 
 //-------------------------------------------------------------------------
@@ -71,6 +79,8 @@ const float PITCH_SCALE   = 0.5f;
 
 const uint8_t MAX_DIRECT_NOTES = (MAX_VOICES >> 2);
 
+const uint32_t MAX_ENV_FRAMES = 64;	// max envelope block render size
+
 
 // maximum helper
 
@@ -310,6 +320,25 @@ struct samplv1_env
 			return value;
 		}
 
+		// render block (nframes within current stage)
+		void render(float *out, uint32_t nframes)
+		{
+			uint32_t n = 0;
+			if (running && frames > 0) {
+				n = (nframes < frames ? nframes : frames);
+				const float phase0 = phase;
+				for (uint32_t j = 0; j < n; ++j) {
+					const float phase1 = phase0 + float(j + 1) * delta;
+					out[j] = c1 * phase1 * (2.0f - phase1) + c0;
+				}
+				phase = phase0 + float(n) * delta;
+				value = out[n - 1];
+				frames -= n;
+			}
+			for (uint32_t j = n; j < nframes; ++j)
+				out[j] = value;
+		}
+
 		// state
 		bool running;
 		Stage stage;
@@ -665,6 +694,7 @@ struct samplv1_dcf
 	samplv1_port  type;
 	samplv1_port  slope;
 	samplv1_port2 envelope;
+	samplv1_port  oversample;
 
 	samplv1_env   env;
 };
@@ -681,6 +711,7 @@ struct samplv1_lfo
 	samplv1_port2 bpm;
 	samplv1_port2 rate;
 	samplv1_port  sync;
+	samplv1_port  global;
 	samplv1_port2 sweep;
 	samplv1_port2 pitch;
 	samplv1_port2 cutoff;
@@ -861,7 +892,8 @@ class samplv1_bal1 : public samplv1_ramp1
 {
 public:
 
-	samplv1_bal1() : samplv1_ramp1(2) {}
+	samplv1_bal1() : samplv1_ramp1(2),
+		m_table(samplv1_fx_sincos::table()) {}
 
 protected:
 
@@ -872,8 +904,15 @@ protected:
 		const float wbal = 0.25f * M_PI
 			* (1.0f + m_param1_v);
 
-		return M_SQRT2 * (i & 1 ? ::sinf(wbal) : ::cosf(wbal));
+		float wsin, wcos;
+		m_table->lookup(wbal, wsin, wcos);
+
+		return M_SQRT2 * (i & 1 ? wsin : wcos);
 	}
+
+private:
+
+	const samplv1_fx_sincos *m_table;
 };
 
 
@@ -883,7 +922,8 @@ class samplv1_bal2 : public samplv1_ramp2
 {
 public:
 
-	samplv1_bal2() : samplv1_ramp2(2) {}
+	samplv1_bal2() : samplv1_ramp2(2),
+		m_table(samplv1_fx_sincos::table()) {}
 
 protected:
 
@@ -895,8 +935,15 @@ protected:
 			* (1.0f + m_param1_v)
 			* (1.0f + m_param2_v);
 
-		return M_SQRT2 * (i & 1 ? ::sinf(wbal) : ::cosf(wbal));
+		float wsin, wcos;
+		m_table->lookup(wbal, wsin, wcos);
+
+		return M_SQRT2 * (i & 1 ? wsin : wcos);
 	}
+
+private:
+
+	const samplv1_fx_sincos *m_table;
 };
 
 
@@ -945,6 +992,146 @@ private:
 };
 
 
+// voice filter pair (active slope only)
+
+class samplv1_filters
+{
+public:
+
+	samplv1_filters(samplv1_formant::Impl *pFormantImpl)
+		: m_slope(-1), m_type(0), m_over(0), m_formant_impl(pFormantImpl) {}
+
+	// (re)initialize active filter pair
+	void reset(int slope, int type, float cutoff, float reso)
+	{
+		m_slope = slope;
+		m_type = type;
+
+		m_over1.reset();
+		m_over2.reset();
+
+		switch (m_slope) {
+		case 3: // Formant
+			new (&m_filters.formant[0]) samplv1_formant(m_formant_impl);
+			new (&m_filters.formant[1]) samplv1_formant(m_formant_impl);
+			m_filters.formant[0].reset_filters(cutoff, reso);
+			m_filters.formant[1].reset_filters(cutoff, reso);
+			break;
+		case 2: // Biquad
+			new (&m_filters.filter3[0]) samplv1_filter3(samplv1_filter3::Type(type));
+			new (&m_filters.filter3[1]) samplv1_filter3(samplv1_filter3::Type(type));
+			break;
+		case 1: // 24db/octave
+			new (&m_filters.filter2[0]) samplv1_filter2(samplv1_filter2::Type(type));
+			new (&m_filters.filter2[1]) samplv1_filter2(samplv1_filter2::Type(type));
+			break;
+		case 0: // 12db/octave
+		default:
+			m_slope = 0;
+			new (&m_filters.filter1[0]) samplv1_filter1(samplv1_filter1::Type(type));
+			new (&m_filters.filter1[1]) samplv1_filter1(samplv1_filter1::Type(type));
+			break;
+		}
+	}
+
+	// stereo output tick (optionally oversampled)
+	void output(float& gen1, float& gen2,
+		int slope, float cutoff, float reso, int over = 0)
+	{
+		if (slope != m_slope)
+			reset(slope, m_type, cutoff, reso);
+
+		// formant filters are never oversampled
+		if (m_slope == 3)
+			over = samplv1_oversampler::Over1x;
+
+		if (over != m_over) {
+			m_over = over;
+			m_over1.reset();
+			m_over2.reset();
+		}
+
+		switch (m_over) {
+		case samplv1_oversampler::Over4x: {
+			float in1[4], in2[4];
+			m_over1.upsample4(gen1, in1);
+			m_over2.upsample4(gen2, in2);
+			const float cutoff4 = 0.25f * cutoff;
+			for (int i = 0; i < 4; ++i)
+				tick(in1[i], in2[i], cutoff4, reso);
+			gen1 = m_over1.downsample4(in1);
+			gen2 = m_over2.downsample4(in2);
+			break;
+		}
+		case samplv1_oversampler::Over2x: {
+			float in1[2], in2[2];
+			m_over1.upsample2(gen1, in1);
+			m_over2.upsample2(gen2, in2);
+			const float cutoff2 = 0.5f * cutoff;
+			tick(in1[0], in2[0], cutoff2, reso);
+			tick(in1[1], in2[1], cutoff2, reso);
+			gen1 = m_over1.downsample2(in1);
+			gen2 = m_over2.downsample2(in2);
+			break;
+		}
+		case samplv1_oversampler::Over1x:
+		default:
+			tick(gen1, gen2, cutoff, reso);
+			break;
+		}
+	}
+
+protected:
+
+	// stereo filter tick (at current rate)
+	void tick(float& gen1, float& gen2, float cutoff, float reso)
+	{
+		switch (m_slope) {
+		case 3: // Formant
+			gen1 = m_filters.formant[0].output(gen1, cutoff, reso);
+			gen2 = m_filters.formant[1].output(gen2, cutoff, reso);
+			break;
+		case 2: // Biquad
+			gen1 = m_filters.filter3[0].output(gen1, cutoff, reso);
+			gen2 = m_filters.filter3[1].output(gen2, cutoff, reso);
+			break;
+		case 1: // 24db/octave
+			gen1 = m_filters.filter2[0].output(gen1, cutoff, reso);
+			gen2 = m_filters.filter2[1].output(gen2, cutoff, reso);
+			break;
+		case 0: // 12db/octave
+		default:
+			gen1 = m_filters.filter1[0].output(gen1, cutoff, reso);
+			gen2 = m_filters.filter1[1].output(gen2, cutoff, reso);
+			break;
+		}
+	}
+
+private:
+
+	// filter state variant, sized for the largest filter
+	union Filters
+	{
+		Filters() {}
+
+		samplv1_filter1 filter1[2];
+		samplv1_filter2 filter2[2];
+		samplv1_filter3 filter3[2];
+		samplv1_formant formant[2];
+
+	} m_filters;
+
+	int m_slope;
+	int m_type;
+	int m_over;
+
+	samplv1_oversampler m_over1;
+	samplv1_oversampler m_over2;
+
+	samplv1_formant::Impl *m_formant_impl;
+};
+
+
 // forward decl.
 
 class samplv1_impl;
@@ -956,27 +1143,30 @@ struct samplv1_voice : public samplv1_list<samplv1_voice>
 {
 	samplv1_voice(samplv1_impl *pImpl);
 
-	int note;									// voice note
-
-	float vel;									// key velocity
-	float pre;									// key pressure/after-touch
+	// hot: touched on every frame...
 
 	samplv1_generator  gen1;					// generator
 	samplv1_oscillator lfo1;					// low frequency oscilattor
 
 	float gen1_freq;							// frequency and phase
+	float gen1_bend;							// per-note pitch bend
 
 	float lfo1_sample;
 
-	samplv1_filter1 dcf11, dcf12;				// filters
-	samplv1_filter2 dcf13, dcf14;
-	samplv1_filter3 dcf15, dcf16;
-	samplv1_formant dcf17, dcf18;
-
 	samplv1_env::State dca1_env;				// envelope states
 	samplv1_env::State dcf1_env;
 	samplv1_env::State lfo1_env;
 
+	samplv1_filters dcf1;						// filters (active pair)
+
+	// cold: touched per block or per note...
+
+	int note;									// voice note
+	int key;									// tuning key (also released)
+
+	float vel;									// key velocity
+	float pre;									// key pressure/after-touch
+
 	samplv1_glide gen1_glide;					// glides (portamento)
 
 	samplv1_pre dca1_pre;
@@ -1025,6 +1215,39 @@ private:
 };
 
 
+// effects buffers (de)allocation (worker/scheduled)
+
+class samplv1_fx_sched : public samplv1_sched
+{
+public:
+
+	samplv1_fx_sched (samplv1 *pSampl, samplv1_impl *pImpl)
+		: samplv1_sched(pSampl, Effects), m_pImpl(pImpl) {}
+
+	void process(int);
+
+private:
+
+	samplv1_impl *m_pImpl;
+};
+
+
+// per-channel effects parallel job
+
+class samplv1_fx_job : public samplv1_pool::Job
+{
+public:
+
+	samplv1_fx_job (samplv1_impl *pImpl) : m_pImpl(pImpl) {}
+
+	void process(uint32_t k);
+
+private:
+
+	samplv1_impl *m_pImpl;
+};
+
+
 // micro-tuning/instance implementation
 
 class samplv1_tun
@@ -1058,6 +1281,7 @@ public:
 	float sampleRate() const;
 
 	void setSampleFile(const char *pszSampleFile, uint16_t otabs);
+	void cancelSampleFile();
 	const char *sampleFile() const;
 	uint16_t octaves() const;
 
@@ -1094,9 +1318,35 @@ public:
 	const char *tuningKeyMapFile() const;
 
 	void resetTuning();
+	void syncTuning();
+
+	void syncEffects();
+
+	void processEffects(uint16_t k);
+
+	void setFlushToZero(bool enabled);
+	bool isFlushToZero() const;
+
+	void setLimiterLookahead(bool enabled);
+	bool isLimiterLookahead() const;
+
+	uint32_t latency() const;
+
+	void setReverbFile(const char *pszReverbFile);
+	const char *reverbFile() const;
 
 	void process_midi(uint8_t *data, uint32_t size);
-	void process(float **ins, float **outs, uint32_t nframes);
+	void process_sysex(const uint8_t *data, uint32_t size);
+	void process_ump(uint8_t *data, uint32_t size);
+	void process_event(const samplv1_event& event)
+	{
+		if (event.ump)
+			process_ump(event.data, event.size);
+		else
+			process_midi(event.data, event.size);
+	}
+	void process(float **ins, float **outs, uint32_t nframes,
+		const samplv1_event *events = nullptr, uint32_t nevents = 0);
 
 	void stabilize();
 	void reset();
@@ -1125,6 +1375,8 @@ public:
 
 	float gen1_last;
 
+	samplv1_oscillator m_lfo1_osc;
+
 	samplv1_formant::Impl dcf1_formant;
 
 protected:
@@ -1133,6 +1385,11 @@ protected:
 	void allControllersOff();
 	void allNotesOff();
 	void allSustainOff();
+
+	void noteOn(int key, float vel);
+	void noteOff(int key);
+
+	void controlChange(int key, int value);
 	void allSustainOn();
 
 	float get_bpm ( float bpm ) const
@@ -1165,19 +1422,36 @@ protected:
 
 	void alloc_sfxs(uint32_t nsize);
 
+	void process_block(float **ins, float **outs, uint32_t nframes,
+		const samplv1_event *events, uint32_t nevents, uint32_t noffset);
+	bool process_voices(float **outs, uint32_t noffset, uint32_t nframes);
+
 private:
 
 	samplv1_config   m_config;
 	samplv1_controls m_controls;
 	samplv1_programs m_programs;
 	samplv1_midi_in  m_midi_in;
+	samplv1_fx_sched m_fx_sched;
 	samplv1_tun      m_tun;
 
 	uint16_t m_nchannels;
 	float    m_srate;
 	float    m_bpm;
 
-	float    m_freqs[MAX_NOTES];
+	// note frequencies: current (real-time) and shadow tables;
+	// next and garbage posted (non-real-time) tables.
+	float   *m_freqs;
+	float    m_freqs_tab[2][MAX_NOTES];
+
+	std::atomic<float *> m_freqs_next;
+	std::atomic<float *> m_freqs_free;
+
+	// UMP system exclusive (7-bit) reassembly buffer.
+	static const uint32_t MAX_SYSEX_SIZE = 512;
+
+	uint8_t  m_sysex[MAX_SYSEX_SIZE];
+	uint32_t m_sysex_size;
 
 	samplv1_ctl m_ctl1;
 
@@ -1211,14 +1485,27 @@ private:
 	float  **m_sfxs;
 	uint32_t m_nsize;
 
+	float   *m_lfo1_buf;
+
 	samplv1_fx_chorus   m_chorus;
 	samplv1_fx_flanger *m_flanger;
 	samplv1_fx_phaser  *m_phaser;
 	samplv1_fx_delay   *m_delay;
 	samplv1_fx_comp    *m_comp;
+	samplv1_fx_limiter *m_limiter;
 
 	samplv1_reverb m_reverb;
 
+	samplv1_convolver m_convolver;
+
+	// per-channel effects (in parallel, when multi-channel)
+	samplv1_pool  *m_fx_pool;
+	samplv1_fx_job m_fx_job;
+
+	uint32_t m_fx_nframes;
+	bool     m_fx_silent0;
+	bool    *m_fx_silent;
+
 	// process direct note on/off...
 	volatile uint16_t m_direct_note;
 
@@ -1229,21 +1516,31 @@ private:
 	volatile int  m_nvoices;
 
 	volatile bool m_running;
+
+	volatile bool m_ftz;
+
+	volatile bool m_limiter_lookahead;
+
+	samplv1_sample_cancel m_sample_cancel;
+	QMutex m_sample_mutex;
+
+	bool m_limiter_active;
 };
 
 
 // voice constructor
 
 samplv1_voice::samplv1_voice ( samplv1_impl *pImpl ) :
-	note(-1),
-	vel(0.0f),
-	pre(0.0f),
 	gen1(nullptr),
 	lfo1(&pImpl->lfo1_wave),
 	gen1_freq(0.0f),
+	gen1_bend(1.0f),
 	lfo1_sample(0.0f),
-	dcf17(&pImpl->dcf1_formant),
-	dcf18(&pImpl->dcf1_formant),
+	dcf1(&pImpl->dcf1_formant),
+	note(-1),
+	key(-1),
+	vel(0.0f),
+	pre(0.0f),
 	gen1_glide(pImpl->gen1_last),
 	out1_panning(0.0f),
 	out1_volume(1.0f),
@@ -1257,7 +1554,8 @@ samplv1_voice::samplv1_voice ( samplv1_impl *pImpl ) :
 samplv1_impl::samplv1_impl (
 	samplv1 *pSampl, uint16_t nchannels, float srate, uint32_t nsize )
 		: m_controls(pSampl), m_programs(pSampl),
-			m_midi_in(pSampl), m_bpm(180.0f), m_gen1(pSampl),
+			m_midi_in(pSampl), m_fx_sched(pSampl, this), m_bpm(180.0f), m_gen1(pSampl),
+			m_fx_job(this),
 			m_nvoices(0), m_running(false)
 {
 	// initialize sample list.
@@ -1287,6 +1585,11 @@ samplv1_impl::samplv1_impl (
 	m_sfxs = nullptr;
 	m_nsize = 0;
 
+	m_lfo1_buf = nullptr;
+
+	// global lfo (free-running)
+	m_lfo1_osc.reset(&lfo1_wave);
+
 	// flangers none yet
 	m_flanger = nullptr;
 
@@ -1299,11 +1602,31 @@ samplv1_impl::samplv1_impl (
 	// compressors none yet
 	m_comp = nullptr;
 
+	// limiters none yet
+	m_limiter = nullptr;
+
+	// per-channel effects none yet
+	m_fx_pool = nullptr;
+	m_fx_silent = nullptr;
+
 	// Pitch-shifting support...
 	samplv1_pshifter::setDefaultType(
 		samplv1_pshifter::Type(m_config.iPitchShiftType));
 
+	// Flush-to-zero/denormals-are-zero mode...
+	m_ftz = m_config.bFlushToZero;
+
+	// Lookahead true-peak limiter mode...
+	m_limiter_lookahead = m_config.bLimiterLookahead;
+	m_limiter_active = false;
+
 	// Micro-tuning support, if any...
+	m_freqs = m_freqs_tab[0];
+	for (int note = 0; note < MAX_NOTES; ++note)
+		m_freqs[note] = samplv1_freq(note);
+	m_freqs_next = nullptr;
+	m_freqs_free = nullptr;
+	m_sysex_size = 0;
 	resetTuning();
 
 	// load controllers & programs database...
@@ -1352,6 +1675,10 @@ samplv1_impl::~samplv1_impl (void)
 
 	// deallocate channels
 	setChannels(0);
+
+	// deallocate posted tunings
+	delete [] m_freqs_free.exchange(nullptr);
+	delete [] m_freqs_next.exchange(nullptr);
 }
 
 
@@ -1382,6 +1709,31 @@ void samplv1_impl::setChannels ( uint16_t nchannels )
 		delete [] m_comp;
 		m_comp = nullptr;
 	}
+
+	// deallocate limiters
+	if (m_limiter) {
+		delete [] m_limiter;
+		m_limiter = nullptr;
+	}
+
+	// deallocate per-channel effects state
+	if (m_fx_silent) {
+		delete [] m_fx_silent;
+		m_fx_silent = nullptr;
+	}
+
+	// deallocate per-channel effects thread pool
+	if (m_fx_pool) {
+		delete m_fx_pool;
+		m_fx_pool = nullptr;
+	}
+
+	// allocate per-channel effects thread pool (multi-channel)
+	if (m_nchannels > 2) {
+		const uint32_t nthreads = samplv1_pool::threads(m_nchannels);
+		if (nthreads > 0)
+			m_fx_pool = new samplv1_pool(nthreads);
+	}
 }
 
 
@@ -1403,6 +1755,8 @@ void samplv1_impl::setSampleRate ( float srate )
 	updateEnvTimes();
 
 	dcf1_formant.setSampleRate(m_srate);
+
+	m_convolver.setSampleRate(m_srate);
 }
 
 
@@ -1414,8 +1768,11 @@ float samplv1_impl::sampleRate (void) const
 
 void samplv1_impl::setBufferSize ( uint32_t nsize )
 {
-	// set nominal buffer size
+	// set nominal (maximum) buffer size; must be called
+	// from a non-real-time context (eg. host negotiation).
 	if (m_nsize < nsize) alloc_sfxs(nsize);
+
+	m_convolver.setBufferSize(m_nsize);
 }
 
 
@@ -1446,6 +1803,8 @@ void samplv1_impl::alloc_sfxs ( uint32_t nsize )
 			delete [] m_sfxs[k];
 		delete [] m_sfxs;
 		m_sfxs = nullptr;
+		delete [] m_lfo1_buf;
+		m_lfo1_buf = nullptr;
 		m_nsize = 0;
 	}
 
@@ -1454,6 +1813,7 @@ void samplv1_impl::alloc_sfxs ( uint32_t nsize )
 		m_sfxs = new float * [m_nchannels];
 		for (uint16_t k = 0; k < m_nchannels; ++k)
 			m_sfxs[k] = new float [m_nsize];
+		m_lfo1_buf = new float [m_nsize];
 	}
 }
 
@@ -1495,12 +1855,30 @@ void samplv1_impl::setSampleFile ( const char *pszSampleFile, uint16_t otabs )
 {
 //	reset();
 
-	samplv1_sample *prev = gen1_sample.prev();
-	samplv1_sample *next = new samplv1_sample(*prev);
+	// supersede any other load in flight...
+	const uint32_t ticket = m_sample_cancel.request();
+
+	// settings snapshot, while it can't be freed by another load...
+	samplv1_sample *next = nullptr;
+	{
+		QMutexLocker locker(&m_sample_mutex);
+		next = new samplv1_sample(*gen1_sample.prev());
+	}
+
 	if (pszSampleFile) {
 		m_gen1.sample0 = *m_gen1.sample;
-		next->open(pszSampleFile, samplv1_freq(m_gen1.sample0), otabs);
+		next->open(pszSampleFile, samplv1_freq(m_gen1.sample0), otabs,
+			&m_sample_cancel, ticket);
 	}
+
+	QMutexLocker locker(&m_sample_mutex);
+
+	// superseded meanwhile? drop it.
+	if (m_sample_cancel.cancelled(ticket)) {
+		delete next;
+		return;
+	}
+
 	gen1_sample.append(next);
 	gen1_sample.free_refs();
 	gen1_sample.clear_refs();
@@ -1509,6 +1887,12 @@ void samplv1_impl::setSampleFile ( const char *pszSampleFile, uint16_t otabs )
 }
 
 
+void samplv1_impl::cancelSampleFile (void)
+{
+	m_sample_cancel.request();
+}
+
+
 const char *samplv1_impl::sampleFile (void) const
 {
 	return gen1_sample.prev()->filename();
@@ -1593,6 +1977,7 @@ samplv1_port *samplv1_impl::paramPort ( samplv1::ParamIndex index )
 	case samplv1::LFO1_BPM:       pParamPort = &m_lfo1.bpm;         break;
 	case samplv1::LFO1_RATE:      pParamPort = &m_lfo1.rate;        break;
 	case samplv1::LFO1_SYNC:      pParamPort = &m_lfo1.sync;        break;
+	case samplv1::LFO1_GLOBAL:    pParamPort = &m_lfo1.global;      break;
 	case samplv1::LFO1_SWEEP:     pParamPort = &m_lfo1.sweep;       break;
 	case samplv1::LFO1_PITCH:     pParamPort = &m_lfo1.pitch;       break;
 	case samplv1::LFO1_CUTOFF:    pParamPort = &m_lfo1.cutoff;      break;
@@ -1646,6 +2031,7 @@ samplv1_port *samplv1_impl::paramPort ( samplv1::ParamIndex index )
 	case samplv1::DYN1_LIMITER:   pParamPort = &m_dyn.limiter;      break;
 	case samplv1::KEY1_LOW:       pParamPort = &m_key.low;          break;
 	case samplv1::KEY1_HIGH:      pParamPort = &m_key.high;         break;
+	case samplv1::DCF1_OVERSAMPLE: pParamPort = &m_dcf1.oversample; break;
 	default: break;
 	}
 
@@ -1672,6 +2058,9 @@ float samplv1_impl::paramValue ( samplv1::ParamIndex index )
 
 void samplv1_impl::process_midi ( uint8_t *data, uint32_t size )
 {
+	// pick up any pending (re)tuning first...
+	syncTuning();
+
 	for (uint32_t i = 0; i < size; ++i) {
 
 		// channel status
@@ -1682,6 +2071,16 @@ void samplv1_impl::process_midi ( uint8_t *data, uint32_t size )
 		const int ch = int(*m_def.channel);
 		const int on = (ch == 0 || ch == channel);
 
+		// system exclusive (MIDI tuning standard)
+		if (data[i] == 0xf0) {
+			uint32_t j = i + 1;
+			while (j < size && data[j] != 0xf7)
+				++j;
+			process_sysex(&data[i + 1], j - i - 1);
+			i = j;
+			continue;
+		}
+
 		// all system common/real-time ignored
 		if (status == 0xf0)
 			continue;
@@ -1720,141 +2119,11 @@ void samplv1_impl::process_midi ( uint8_t *data, uint32_t size )
 
 		// note on
 		if (status == 0x90 && value > 0) {
-			if (!m_key.is_note(key))
-				continue;
-			samplv1_voice *pv;
-			// mono voice modes
-			if (*m_def.mono > 0.0f) {
-				int n = 0;
-				for (pv = m_play_list.next(); pv; pv = pv->next()) {
-					if (pv->note >= 0
-						&& pv->dca1_env.stage != samplv1_env::Release) {
-						m_dcf1.env.note_off_fast(&pv->dcf1_env);
-						m_lfo1.env.note_off_fast(&pv->lfo1_env);
-						m_dca1.env.note_off_fast(&pv->dca1_env);
-						if (++n > 1) { // there shall be only one
-							m_notes[pv->note] = nullptr;
-							pv->note = -1;
-						}
-					}
-				}
-			}
-			pv = m_notes[key];
-			if (pv && pv->note >= 0/* && !m_ctl1.sustain*/) {
-				// retrigger fast release
-				m_dcf1.env.note_off_fast(&pv->dcf1_env);
-				m_lfo1.env.note_off_fast(&pv->lfo1_env);
-				m_dca1.env.note_off_fast(&pv->dca1_env);
-				m_notes[pv->note] = nullptr;
-				pv->note = -1;
-			}
-			// find free voice
-			pv = alloc_voice();
-			if (pv) {
-				// waveform
-				pv->note = key;
-				// velocity
-				const float vel = float(value) / 127.0f;
-				// quadratic velocity law
-				pv->vel = samplv1_velocity(vel * vel, *m_def.velocity);
-				// pressure/after-touch
-				pv->pre = 0.0f;
-				pv->dca1_pre.reset(
-					m_def.pressure.value_ptr(),
-					&m_ctl1.pressure, &pv->pre);
-				// frequencies
-				const float gen1_tuning
-					= *m_gen1.octave * OCTAVE_SCALE
-					+ *m_gen1.tuning * TUNING_SCALE;
-				pv->gen1_freq = m_freqs[key] * samplv1_freq2(gen1_tuning);
-				// generator
-				pv->gen1.start(pv->gen1_freq);
-				// filters
-				const int dcf1_type = int(*m_dcf1.type);
-				pv->dcf11.reset(samplv1_filter1::Type(dcf1_type));
-				pv->dcf12.reset(samplv1_filter1::Type(dcf1_type));
-				pv->dcf13.reset(samplv1_filter2::Type(dcf1_type));
-				pv->dcf14.reset(samplv1_filter2::Type(dcf1_type));
-				pv->dcf15.reset(samplv1_filter3::Type(dcf1_type));
-				pv->dcf16.reset(samplv1_filter3::Type(dcf1_type));
-				// formant filters
-				const float dcf1_cutoff = *m_dcf1.cutoff;
-				const float dcf1_reso = *m_dcf1.reso;
-				pv->dcf17.reset_filters(dcf1_cutoff, dcf1_reso);
-				pv->dcf18.reset_filters(dcf1_cutoff, dcf1_reso);
-				// envelopes
-				if (*m_dcf1.enabled > 0.0f)
-					m_dcf1.env.start(&pv->dcf1_env);
-				else
-					m_dcf1.env.idle(&pv->dcf1_env);
-				if (*m_lfo1.enabled > 0.0f)
-					m_lfo1.env.start(&pv->lfo1_env);
-				else
-					m_lfo1.env.idle(&pv->lfo1_env);
-				if (*m_dca1.enabled > 0.0f)
-					m_dca1.env.start(&pv->dca1_env);
-				else
-					m_dca1.env.idle(&pv->dca1_env);
-				// something about the loop
-				pv->gen1.setLoop(gen1_sample.next()->isLoop());
-				// lfos
-				const float lfo1_pshift
-					= (m_lfo1.psync ? m_lfo1.psync->lfo1.pshift() : 0.0f);
-				pv->lfo1_sample = pv->lfo1.start(lfo1_pshift);
-				if (*m_lfo1.sync > 0.0f && m_lfo1.psync == nullptr)
-					m_lfo1.psync = pv;
-				// glides (portamentoa)
-				const float gen1_frames
-					= uint32_t(*m_gen1.glide * *m_gen1.glide * m_srate);
-				pv->gen1_glide.reset(gen1_frames, pv->gen1_freq);
-				// panning
-				pv->out1_panning = 0.0f;
-				pv->out1_pan.reset(&pv->out1_panning);
-				// volume
-				pv->out1_volume = 1.0f;
-				pv->out1_vol.reset(&pv->out1_volume);
-				// sustain
-				pv->sustain = false;
-				// allocated
-				m_notes[key] = pv;
-			}
-			m_midi_in.schedule_note(key, value);
+			noteOn(key, float(value) / 127.0f);
 		}
 		// note off
 		else if (status == 0x80 || (status == 0x90 && value == 0)) {
-			if (!m_key.is_note(key))
-				continue;
-			samplv1_voice *pv = m_notes[key];
-			if (pv && pv->note >= 0) {
-				if (m_ctl1.sustain)
-					pv->sustain = true;
-				else
-				if (!pv->sustain) {
-					if (pv->dca1_env.stage != samplv1_env::Release) {
-						m_dca1.env.note_off(&pv->dca1_env);
-						m_dcf1.env.note_off(&pv->dcf1_env);
-						m_lfo1.env.note_off(&pv->lfo1_env);
-						if (gen1_sample.next()->isLoopEndRelease())
-							pv->gen1.setLoop(false);
-					}
-					m_notes[pv->note] = nullptr;
-					pv->note = -1;
-					// mono legato?
-					if (*m_def.mono > 0.0f) {
-						do pv = pv->prev();	while (pv && pv->note < 0);
-						if (pv && pv->note >= 0) {
-							const bool legato = (*m_def.mono > 1.0f);
-							m_dcf1.env.restart(&pv->dcf1_env, legato);
-							m_lfo1.env.restart(&pv->lfo1_env, legato);
-							m_dca1.env.restart(&pv->dca1_env, legato);
-							pv->gen1.setLoop(*m_gen1.loop > 0.0f);
-							if (!legato) pv->gen1.start(pv->gen1_freq);
-							m_notes[pv->note] = pv;
-						}
-					}
-				}
-			}
-			m_midi_in.schedule_note(key, 0);
+			noteOff(key);
 		}
 		// key pressure/poly.aftertouch
 		else if (status == 0xa0) {
@@ -1866,53 +2135,7 @@ void samplv1_impl::process_midi ( uint8_t *data, uint32_t size )
 		}
 		// control change
 		else if (status == 0xb0) {
-		switch (key) {
-			case 0x00:
-				// bank-select MSB (cc#0)
-				m_programs.bank_select_msb(value);
-				break;
-			case 0x01:
-				// modulation wheel (cc#1)
-				m_ctl1.modwheel = *m_def.modwheel * float(value) / 127.0f;
-				break;
-			case 0x07:
-				// channel volume (cc#7)
-				m_ctl1.volume = float(value) / 127.0f;
-				break;
-			case 0x0a:
-				// channel panning (cc#10)
-				m_ctl1.panning = float(value - 64) / 64.0f;
-				break;
-			case 0x20:
-				// bank-select LSB (cc#32)
-				m_programs.bank_select_lsb(value);
-				break;
-			case 0x40:
-				// sustain/damper pedal (cc#64)
-				if (m_ctl1.sustain && value <  64)
-					allSustainOff();
-				m_ctl1.sustain = bool(value >= 64);
-				break;
-			case 0x42:
-				// sustenuto pedal (cc#66)
-				if (value < 64)
-					allSustainOff();
-				else
-					allSustainOn();
-				break;
-			case 0x78:
-				// all sound off (cc#120)
-				allSoundOff();
-				break;
-			case 0x79:
-				// all controllers off (cc#121)
-				allControllersOff();
-				break;
-			case 0x7b:
-				// all notes off (cc#123)
-				allNotesOff();
-				break;
-			}
+			controlChange(key, value);
 			// process controllers...
 			m_controls.process_enqueue(channel, key, value);
 		}
@@ -1950,10 +2173,12 @@ void samplv1_impl::allSoundOff (void)
 		m_phaser[k].setSampleRate(m_srate);
 		m_delay[k].setSampleRate(m_srate);
 		m_comp[k].setSampleRate(m_srate);
+		m_limiter[k].setSampleRate(m_srate);
 		m_flanger[k].reset();
 		m_phaser[k].reset();
 		m_delay[k].reset();
 		m_comp[k].reset();
+		m_limiter[k].reset();
 	}
 
 	m_reverb.setSampleRate(m_srate);
@@ -1977,10 +2202,204 @@ void samplv1_impl::allNotesOff (void)
 
 	m_lfo1.psync = nullptr;
 
+	m_lfo1_osc.reset(&lfo1_wave);
+
 	m_direct_note = 0;
 }
 
 
+// note on/off (velocity 0..1)
+
+void samplv1_impl::noteOn ( int key, float vel )
+{
+	if (!m_key.is_note(key))
+		return;
+	samplv1_voice *pv;
+	// mono voice modes
+	if (*m_def.mono > 0.0f) {
+		int n = 0;
+		for (pv = m_play_list.next(); pv; pv = pv->next()) {
+			if (pv->note >= 0
+				&& pv->dca1_env.stage != samplv1_env::Release) {
+				m_dcf1.env.note_off_fast(&pv->dcf1_env);
+				m_lfo1.env.note_off_fast(&pv->lfo1_env);
+				m_dca1.env.note_off_fast(&pv->dca1_env);
+				if (++n > 1) { // there shall be only one
+					m_notes[pv->note] = nullptr;
+					pv->note = -1;
+				}
+			}
+		}
+	}
+	pv = m_notes[key];
+	if (pv && pv->note >= 0/* && !m_ctl1.sustain*/) {
+		// retrigger fast release
+		m_dcf1.env.note_off_fast(&pv->dcf1_env);
+		m_lfo1.env.note_off_fast(&pv->lfo1_env);
+		m_dca1.env.note_off_fast(&pv->dca1_env);
+		m_notes[pv->note] = nullptr;
+		pv->note = -1;
+	}
+	// find free voice
+	pv = alloc_voice();
+	if (pv) {
+		// waveform
+		pv->note = key;
+		pv->key = key;
+		// quadratic velocity law
+		pv->vel = samplv1_velocity(vel * vel, *m_def.velocity);
+		// pressure/after-touch
+		pv->pre = 0.0f;
+		pv->dca1_pre.reset(
+			m_def.pressure.value_ptr(),
+			&m_ctl1.pressure, &pv->pre);
+		// frequencies
+		const float gen1_tuning
+			= *m_gen1.octave * OCTAVE_SCALE
+			+ *m_gen1.tuning * TUNING_SCALE;
+		pv->gen1_freq = m_freqs[key] * samplv1_freq2(gen1_tuning);
+		pv->gen1_bend = 1.0f;
+		// generator
+		pv->gen1.start(pv->gen1_freq);
+		// filters
+		pv->dcf1.reset(int(*m_dcf1.slope), int(*m_dcf1.type),
+			*m_dcf1.cutoff, *m_dcf1.reso);
+		// envelopes
+		if (*m_dcf1.enabled > 0.0f)
+			m_dcf1.env.start(&pv->dcf1_env);
+		else
+			m_dcf1.env.idle(&pv->dcf1_env);
+		if (*m_lfo1.enabled > 0.0f)
+			m_lfo1.env.start(&pv->lfo1_env);
+		else
+			m_lfo1.env.idle(&pv->lfo1_env);
+		if (*m_dca1.enabled > 0.0f)
+			m_dca1.env.start(&pv->dca1_env);
+		else
+			m_dca1.env.idle(&pv->dca1_env);
+		// something about the loop
+		pv->gen1.setLoop(gen1_sample.next()->isLoop());
+		// lfos
+		const float lfo1_pshift
+			= (m_lfo1.psync ? m_lfo1.psync->lfo1.pshift() : 0.0f);
+		pv->lfo1_sample = pv->lfo1.start(lfo1_pshift);
+		if (*m_lfo1.sync > 0.0f && m_lfo1.psync == nullptr) {
+			// global lfo restarts on first synced note
+			if (*m_lfo1.global > 0.0f)
+				m_lfo1_osc.start();
+			m_lfo1.psync = pv;
+		}
+		// glides (portamentoa)
+		const float gen1_frames
+			= uint32_t(*m_gen1.glide * *m_gen1.glide * m_srate);
+		pv->gen1_glide.reset(gen1_frames, pv->gen1_freq);
+		// panning
+		pv->out1_panning = 0.0f;
+		pv->out1_pan.reset(&pv->out1_panning);
+		// volume
+		pv->out1_volume = 1.0f;
+		pv->out1_vol.reset(&pv->out1_volume);
+		// sustain
+		pv->sustain = false;
+		// allocated
+		m_notes[key] = pv;
+	}
+	m_midi_in.schedule_note(key, int(127.0f * vel + 0.5f));
+}
+
+
+void samplv1_impl::noteOff ( int key )
+{
+	if (!m_key.is_note(key))
+		return;
+	samplv1_voice *pv = m_notes[key];
+	if (pv && pv->note >= 0) {
+		if (m_ctl1.sustain)
+			pv->sustain = true;
+		else
+		if (!pv->sustain) {
+			if (pv->dca1_env.stage != samplv1_env::Release) {
+				m_dca1.env.note_off(&pv->dca1_env);
+				m_dcf1.env.note_off(&pv->dcf1_env);
+				m_lfo1.env.note_off(&pv->lfo1_env);
+				if (gen1_sample.next()->isLoopEndRelease())
+					pv->gen1.setLoop(false);
+			}
+			m_notes[pv->note] = nullptr;
+			pv->note = -1;
+			// mono legato?
+			if (*m_def.mono > 0.0f) {
+				do pv = pv->prev();	while (pv && pv->note < 0);
+				if (pv && pv->note >= 0) {
+					const bool legato = (*m_def.mono > 1.0f);
+					m_dcf1.env.restart(&pv->dcf1_env, legato);
+					m_lfo1.env.restart(&pv->lfo1_env, legato);
+					m_dca1.env.restart(&pv->dca1_env, legato);
+					pv->gen1.setLoop(*m_gen1.loop > 0.0f);
+					if (!legato) pv->gen1.start(pv->gen1_freq);
+					m_notes[pv->note] = pv;
+				}
+			}
+		}
+	}
+	m_midi_in.schedule_note(key, 0);
+}
+
+
+// control change (7-bit value)
+
+void samplv1_impl::controlChange ( int key, int value )
+{
+	switch (key) {
+	case 0x00:
+		// bank-select MSB (cc#0)
+		m_programs.bank_select_msb(value);
+		break;
+	case 0x01:
+		// modulation wheel (cc#1)
+		m_ctl1.modwheel = *m_def.modwheel * float(value) / 127.0f;
+		break;
+	case 0x07:
+		// channel volume (cc#7)
+		m_ctl1.volume = float(value) / 127.0f;
+		break;
+	case 0x0a:
+		// channel panning (cc#10)
+		m_ctl1.panning = float(value - 64) / 64.0f;
+		break;
+	case 0x20:
+		// bank-select LSB (cc#32)
+		m_programs.bank_select_lsb(value);
+		break;
+	case 0x40:
+		// sustain/damper pedal (cc#64)
+		if (m_ctl1.sustain && value <  64)
+			allSustainOff();
+		m_ctl1.sustain = bool(value >= 64);
+		break;
+	case 0x42:
+		// sustenuto pedal (cc#66)
+		if (value < 64)
+			allSustainOff();
+		else
+			allSustainOn();
+		break;
+	case 0x78:
+		// all sound off (cc#120)
+		allSoundOff();
+		break;
+	case 0x79:
+		// all controllers off (cc#121)
+		allControllersOff();
+		break;
+	case 0x7b:
+		// all notes off (cc#123)
+		allNotesOff();
+		break;
+	}
+}
+
+
 // all sustained notes off
 
 void samplv1_impl::allSustainOff (void)
@@ -2111,6 +2530,8 @@ const char *samplv1_impl::tuningKeyMapFile (void) const
 
 void samplv1_impl::resetTuning (void)
 {
+	float *freqs = new float [MAX_NOTES];
+
 	if (m_tun.enabled) {
 		// Instance micro-tuning, possibly from Scala keymap and scale files...
 		samplv1_tuning tuning(
@@ -2122,7 +2543,7 @@ void samplv1_impl::resetTuning (void)
 		if (!m_tun.scaleFile.isEmpty())
 			tuning.loadScaleFile(m_tun.scaleFile);
 		for (int note = 0; note < MAX_NOTES; ++note)
-			m_freqs[note] = tuning.noteToPitch(note);
+			freqs[note] = tuning.noteToPitch(note);
 		// Done instance tuning.
 	}
 	else
@@ -2136,34 +2557,413 @@ void samplv1_impl::resetTuning (void)
 		if (!m_config.sTuningScaleFile.isEmpty())
 			tuning.loadScaleFile(m_config.sTuningScaleFile);
 		for (int note = 0; note < MAX_NOTES; ++note)
-			m_freqs[note] = tuning.noteToPitch(note);
+			freqs[note] = tuning.noteToPitch(note);
 		// Done global/config tuning.
 	} else {
 		// Native/default tuning, 12-tone equal temperament western standard...
 		for (int note = 0; note < MAX_NOTES; ++note)
-			m_freqs[note] = samplv1_freq(note);
+			freqs[note] = samplv1_freq(note);
 		// Done native/default tuning.
 	}
+
+	// free whatever the real-time thread left behind...
+	delete [] m_freqs_free.exchange(nullptr, std::memory_order_acq_rel);
+
+	// replace any previous one never picked up...
+	delete [] m_freqs_next.exchange(freqs, std::memory_order_acq_rel);
 }
 
 
-// all stabilize
+// handle MIDI 2.0 universal MIDI packet (UMP) input
 
-void samplv1_impl::stabilize (void)
+void samplv1_impl::process_ump ( uint8_t *data, uint32_t size )
 {
-	for (int i = 0; i < samplv1::NUM_PARAMS; ++i) {
-		samplv1_port *pParamPort = paramPort(samplv1::ParamIndex(i));
-		if (pParamPort)
-			pParamPort->tick(samplv1_port2::NSTEP);
-	}
-}
+	// pick up any pending (re)tuning first...
+	syncTuning();
 
+	// packet size (32-bit words) per message type.
+	static const uint32_t s_nwords[16]
+		= { 1, 1, 1, 2, 2, 4, 1, 1, 2, 2, 2, 3, 3, 4, 4, 4 };
 
-// all reset clear
+	const uint32_t nwords = (size >> 2);
 
-void samplv1_impl::reset (void)
-{
-	m_vol1.reset(
+	uint32_t i = 0;
+	while (i < nwords) {
+
+		uint32_t w[2] = { 0, 0 };
+		::memcpy(&w[0], data + (i << 2), sizeof(uint32_t));
+
+		const int mtype = (w[0] >> 28);
+		const uint32_t n = s_nwords[mtype];
+		if (i + n > nwords)
+			break;
+		if (n > 1)
+			::memcpy(&w[1], data + ((i + 1) << 2), sizeof(uint32_t));
+		i += n;
+
+		// MIDI 1.0 channel voice message
+		if (mtype == 0x2) {
+			uint8_t midi[3];
+			midi[0] = (w[0] >> 16) & 0xff;
+			midi[1] = (w[0] >> 8) & 0x7f;
+			midi[2] = (w[0] & 0x7f);
+			const int status = (midi[0] & 0xf0);
+			process_midi(midi, (status == 0xc0 || status == 0xd0 ? 2 : 3));
+			continue;
+		}
+
+		// 7-bit system exclusive (MIDI tuning standard)
+		if (mtype == 0x3) {
+			const int sstatus = (w[0] >> 20) & 0x0f;
+			uint32_t nbytes = (w[0] >> 16) & 0x0f;
+			if (nbytes > 6)
+				nbytes = 6;
+			if (sstatus == 0x0 || sstatus == 0x1)
+				m_sysex_size = 0; // complete or start.
+			for (uint32_t k = 0; k < nbytes; ++k) {
+				const uint32_t shift = (k < 2 ? 8 - (k << 3) : 40 - (k << 3));
+				const uint8_t b = (w[k < 2 ? 0 : 1] >> shift) & 0x7f;
+				if (m_sysex_size < MAX_SYSEX_SIZE)
+					m_sysex[m_sysex_size++] = b;
+			}
+			if (sstatus == 0x0 || sstatus == 0x3) { // complete or end.
+				if (m_sysex_size < MAX_SYSEX_SIZE)
+					process_sysex(m_sysex, m_sysex_size);
+				m_sysex_size = 0;
+			}
+			continue;
+		}
+
+		// MIDI 2.0 channel voice messages only
+		if (mtype != 0x4)
+			continue;
+
+		const int status  = (w[0] >> 20) & 0x0f;
+		const int channel = ((w[0] >> 16) & 0x0f) + 1;
+		const int key     = (w[0] >> 8) & 0x7f;
+
+		// channel filter
+		const int ch = int(*m_def.channel);
+		const int on = (ch == 0 || ch == channel);
+
+		// 32-bit value (scaled in double precision, as a float
+		// can't hold it all: rounded once, to the nearest float)
+		const float value = float(double(w[1]) / 4294967295.0);
+
+		// registered/assignable controllers (RPN/NRPN)
+		if (status == 0x2 || status == 0x3) {
+			m_controls.process_value(
+				(status == 0x2 ? samplv1_controls::RPN : samplv1_controls::NRPN),
+				channel, (key << 7) | (w[0] & 0x7f), value);
+			continue;
+		}
+
+		// control change
+		if (status == 0xb) {
+			if (on) {
+				switch (key) {
+				case 0x01:
+					// modulation wheel (cc#1)
+					m_ctl1.modwheel = *m_def.modwheel * value;
+					break;
+				case 0x07:
+					// channel volume (cc#7)
+					m_ctl1.volume = value;
+					break;
+				case 0x0a:
+					// channel panning (cc#10)
+					m_ctl1.panning = float(int64_t(w[1]) - 0x80000000LL)
+						/ 2147483648.0f;
+					break;
+				default:
+					controlChange(key, (w[1] >> 25));
+					break;
+				}
+			}
+			// process controllers...
+			m_controls.process_value(samplv1_controls::CC, channel, key, value);
+			continue;
+		}
+
+		// channel filter
+		if (!on)
+			continue;
+
+		// note on (16-bit velocity)
+		if (status == 0x9) {
+			noteOn(key, float(w[1] >> 16) / 65535.0f);
+		}
+		// note off
+		else if (status == 0x8) {
+			noteOff(key);
+		}
+		// key pressure/poly.aftertouch
+		else if (status == 0xa) {
+			if (!m_key.is_note(key))
+				continue;
+			samplv1_voice *pv = m_notes[key];
+			if (pv && pv->note >= 0)
+				pv->pre = *m_def.pressure * value;
+		}
+		// per-note pitch bend (+/-48 semitones, default range)
+		else if (status == 0x6) {
+			samplv1_voice *pv = m_notes[key];
+			if (pv && pv->note >= 0) {
+				const float bend = float(int64_t(w[1]) - 0x80000000LL)
+					/ 2147483648.0f;
+				pv->gen1_bend = samplv1_freq2(48.0f * bend);
+			}
+		}
+		// program change (and bank select)
+		else if (status == 0xc) {
+			if (w[0] & 0x01) {
+				m_programs.bank_select_msb((w[1] >> 8) & 0x7f);
+				m_programs.bank_select_lsb(w[1] & 0x7f);
+			}
+			m_programs.prog_change((w[1] >> 24) & 0x7f);
+		}
+		// channel aftertouch
+		else if (status == 0xd) {
+			m_ctl1.pressure = value;
+		}
+		// pitch bend
+		else if (status == 0xe) {
+			const float pitchbend = float(int64_t(w[1]) - 0x80000000LL)
+				/ 2147483648.0f;
+			m_ctl1.pitchbend = samplv1_pow2f(*m_def.pitchbend * pitchbend);
+		}
+	}
+
+	// process pending controllers...
+	m_controls.process_dequeue();
+
+	// asynchronous event notification...
+	m_midi_in.schedule_event();
+}
+
+
+// real-time: pick up any pending (posted) tuning.
+
+void samplv1_impl::syncTuning (void)
+{
+	// only when the previous one has been freed...
+	if (m_freqs_next.load(std::memory_order_acquire) == nullptr ||
+		m_freqs_free.load(std::memory_order_acquire) != nullptr)
+		return;
+
+	float *freqs = m_freqs_next.exchange(nullptr, std::memory_order_acq_rel);
+	if (freqs) {
+		::memcpy(m_freqs, freqs, MAX_NOTES * sizeof(float));
+		m_freqs_free.store(freqs, std::memory_order_release);
+	}
+}
+
+
+// real-time: MIDI tuning standard (MTS) system exclusive;
+// data excludes the leading 0xf0 and trailing 0xf7 bytes.
+
+void samplv1_impl::process_sysex ( const uint8_t *data, uint32_t size )
+{
+	// universal (non-)real-time, any device, MIDI tuning standard.
+	if (size < 5 || (data[0] != 0x7e && data[0] != 0x7f) || data[2] != 0x08)
+		return;
+
+	// new tuning is built on the shadow table...
+	float *freqs = (m_freqs == m_freqs_tab[0] ? m_freqs_tab[1] : m_freqs_tab[0]);
+	::memcpy(freqs, m_freqs, MAX_NOTES * sizeof(float));
+
+	const uint8_t subid = data[3];
+
+	// bulk tuning dump (and with bank)
+	if (subid == 0x01 || subid == 0x04) {
+		const uint32_t i0 = (subid == 0x04 ? 22 : 21);
+		if (size < i0 + 3 * MAX_NOTES)
+			return;
+		for (int note = 0; note < MAX_NOTES; ++note) {
+			const uint8_t *p = &data[i0 + 3 * note];
+			if (p[0] == 0x7f && p[1] == 0x7f && p[2] == 0x7f)
+				continue; // no change.
+			const int frac = ((p[1] & 0x7f) << 7) | (p[2] & 0x7f);
+			freqs[note] = samplv1_freq(p[0] & 0x7f)
+				* samplv1_freq2(float(frac) / 16384.0f);
+		}
+	}
+	else
+	// single note tuning change (and with bank)
+	if (subid == 0x02 || subid == 0x07) {
+		const uint32_t i0 = (subid == 0x07 ? 7 : 6);
+		if (size < i0)
+			return;
+		uint32_t n = data[i0 - 1];
+		if (size < i0 + 4 * n)
+			n = (size - i0) / 4;
+		for (uint32_t i = 0; i < n; ++i) {
+			const uint8_t *p = &data[i0 + 4 * i];
+			if (p[1] == 0x7f && p[2] == 0x7f && p[3] == 0x7f)
+				continue; // no change.
+			const int frac = ((p[2] & 0x7f) << 7) | (p[3] & 0x7f);
+			freqs[p[0] & 0x7f] = samplv1_freq(p[1] & 0x7f)
+				* samplv1_freq2(float(frac) / 16384.0f);
+		}
+	}
+	else
+	// scale/octave tuning, 1-byte and 2-byte forms
+	if (subid == 0x08 || subid == 0x09) {
+		const uint32_t nbytes = (subid == 0x09 ? 2 : 1);
+		if (size < 7 + 12 * nbytes)
+			return;
+		// channel mask: bits 15-16, 8-14 and 1-7.
+		const uint32_t mask = (uint32_t(data[4] & 0x03) << 14)
+			| (uint32_t(data[5] & 0x7f) << 7) | (data[6] & 0x7f);
+		const int ch = int(*m_def.channel);
+		if (ch > 0 ? (mask & (1 << (ch - 1))) == 0 : mask == 0)
+			return;
+		float cents[12];
+		for (int k = 0; k < 12; ++k) {
+			const uint8_t *p = &data[7 + nbytes * k];
+			if (nbytes > 1) // 0x2000 = 0, +/-100 cents.
+				cents[k] = float((((p[0] & 0x7f) << 7) | (p[1] & 0x7f)) - 0x2000)
+					* (100.0f / 8192.0f);
+			else // 0x40 = 0, -64..+63 cents.
+				cents[k] = float((p[0] & 0x7f) - 0x40);
+		}
+		for (int note = 0; note < MAX_NOTES; ++note)
+			freqs[note] = samplv1_freq(note)
+				* samplv1_freq2(0.01f * cents[note % 12]);
+	}
+	else return;
+
+	// real-time form: retune all sounding voices, right away;
+	// non-real-time form: new notes only.
+	if (data[0] == 0x7f) {
+		samplv1_voice *pv = m_play_list.next();
+		for ( ; pv; pv = pv->next()) {
+			const int key = pv->key;
+			if (key >= 0 && key < MAX_NOTES && m_freqs[key] > 0.0f)
+				pv->gen1_freq *= freqs[key] / m_freqs[key];
+		}
+	}
+
+	// swap in the new tuning...
+	m_freqs = freqs;
+}
+
+
+// effects buffers (de)allocation (worker/scheduled)
+
+void samplv1_impl::syncEffects (void)
+{
+	m_convolver.sync_buffers();
+
+	if (m_delay == nullptr)
+		return;
+
+	for (uint16_t k = 0; k < m_nchannels; ++k)
+		m_delay[k].sync_buffers();
+}
+
+
+void samplv1_fx_sched::process ( int )
+{
+	m_pImpl->syncEffects();
+}
+
+
+// per-channel effects chain (flanger, phaser, delay)
+
+void samplv1_impl::processEffects ( uint16_t k )
+{
+	const uint32_t nframes = m_fx_nframes;
+
+	float *in = m_sfxs[k];
+	bool silent = m_fx_silent0;
+	// flanger
+	silent = m_flanger[k].process(in, nframes, *m_fla.wet,
+		*m_fla.delay, *m_fla.feedb, *m_fla.daft * float(k), silent);
+	// phaser
+	silent = m_phaser[k].process(in, nframes, *m_pha.wet,
+		*m_pha.rate, *m_pha.feedb, *m_pha.depth, *m_pha.daft * float(k), silent);
+	// delay
+	silent = m_delay[k].process(in, nframes, *m_del.wet,
+		*m_del.delay, *m_del.feedb, get_bpm(*m_del.bpm), silent);
+
+	m_fx_silent[k] = silent;
+}
+
+
+void samplv1_fx_job::process ( uint32_t k )
+{
+	m_pImpl->processEffects(k);
+}
+
+
+// Flush-to-zero/denormals-are-zero mode
+
+void samplv1_impl::setFlushToZero ( bool enabled )
+{
+	m_ftz = enabled;
+}
+
+bool samplv1_impl::isFlushToZero (void) const
+{
+	return m_ftz;
+}
+
+
+// Lookahead true-peak limiter mode
+
+void samplv1_impl::setLimiterLookahead ( bool enabled )
+{
+	m_limiter_lookahead = enabled;
+}
+
+bool samplv1_impl::isLimiterLookahead (void) const
+{
+	return m_limiter_lookahead;
+}
+
+
+// Processing latency (frames)
+
+uint32_t samplv1_impl::latency (void) const
+{
+	return (m_limiter_active ? samplv1_fx_limiter::LATENCY : 0);
+}
+
+
+// Convolution reverb impulse response file
+
+void samplv1_impl::setReverbFile ( const char *pszReverbFile )
+{
+	if (pszReverbFile && *pszReverbFile)
+		m_convolver.open(pszReverbFile);
+	else
+		m_convolver.close();
+}
+
+const char *samplv1_impl::reverbFile (void) const
+{
+	return m_convolver.filename();
+}
+
+
+// all stabilize
+
+void samplv1_impl::stabilize (void)
+{
+	for (int i = 0; i < samplv1::NUM_PARAMS; ++i) {
+		samplv1_port *pParamPort = paramPort(samplv1::ParamIndex(i));
+		if (pParamPort)
+			pParamPort->tick(samplv1_port2::NSTEP);
+	}
+}
+
+
+// all reset clear
+
+void samplv1_impl::reset (void)
+{
+	m_vol1.reset(
 		m_out1.volume.value_ptr(),
 		m_dca1.volume.value_ptr(),
 		&m_ctl1.volume);
@@ -2189,8 +2989,17 @@ void samplv1_impl::reset (void)
 	if (m_comp == nullptr)
 		m_comp = new samplv1_fx_comp [m_nchannels];
 
+	// limiters
+	if (m_limiter == nullptr)
+		m_limiter = new samplv1_fx_limiter [m_nchannels];
+
+	// per-channel effects state
+	if (m_fx_silent == nullptr)
+		m_fx_silent = new bool [m_nchannels];
+
 	// reverbs
 	m_reverb.reset();
+	m_convolver.reset();
 
 	// controllers reset.
 	m_controls.reset();
@@ -2217,16 +3026,49 @@ uint32_t samplv1_impl::midiInCount (void)
  
 // synthesize
 
-void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
+void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes,
+	const samplv1_event *events, uint32_t nevents )
 {
-	if (!m_running) return;
+	if (!m_running || m_nsize < 1 || nframes < 1) {
+		// nothing to render, still take all events...
+		for (uint32_t n = 0; n < nevents; ++n)
+			process_event(events[n]);
+		return;
+	}
 
-	float *v_outs[m_nchannels];
-	float *v_sfxs[m_nchannels];
+	// fx-send buffers are never reallocated here;
+	// oversized blocks are split in nominal sized chunks...
+	if (nframes > m_nsize) {
+		float *c_ins[m_nchannels];
+		float *c_outs[m_nchannels];
+		uint32_t noffset = 0;
+		uint32_t n = 0;
+		while (noffset < nframes) {
+			uint32_t nblock = nframes - noffset;
+			if (nblock > m_nsize)
+				nblock = m_nsize;
+			for (uint16_t k = 0; k < m_nchannels; ++k) {
+				c_ins[k]  = ins[k]  + noffset;
+				c_outs[k] = outs[k] + noffset;
+			}
+			// events due in this chunk (or all left, on the last one)
+			const uint32_t n0 = n;
+			if (noffset + nblock < nframes) {
+				while (n < nevents && events[n].frame < noffset + nblock)
+					++n;
+			}
+			else n = nevents;
+			process_block(c_ins, c_outs, nblock, events + n0, n - n0, noffset);
+			noffset += nblock;
+		}
+	}
+	else process_block(ins, outs, nframes, events, nevents, 0);
+}
 
-	// FIXME: fx-send buffer reallocation... seriously?
-	if (m_nsize < nframes) alloc_sfxs(nframes);
 
+void samplv1_impl::process_block ( float **ins, float **outs, uint32_t nframes,
+	const samplv1_event *events, uint32_t nevents, uint32_t noffset )
+{
 	uint16_t k;
 
 	for (k = 0; k < m_nchannels; ++k) {
@@ -2241,6 +3083,158 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		process_midi((uint8_t *) &data, sizeof(data));
 	}
 
+	if (m_gen1.sample0 != *m_gen1.sample) {
+		m_gen1.sample0  = *m_gen1.sample;
+		gen1_sample.next()->reset(samplv1_freq(m_gen1.sample0));
+	}
+
+	if (m_gen1.envtime0 != *m_gen1.envtime) {
+		m_gen1.envtime0  = *m_gen1.envtime;
+		updateEnvTimes();
+	}
+
+	if (*m_lfo1.enabled > 0.0f) {
+		lfo1_wave.reset_test(
+			samplv1_wave::Shape(*m_lfo1.shape), *m_lfo1.width);
+	}
+
+	// voices, split at each event offset
+
+	bool sfxs_silent = true;
+
+	uint32_t j0 = 0;
+	uint32_t n  = 0;
+
+	while (j0 < nframes) {
+		while (n < nevents && events[n].frame <= noffset + j0) {
+			process_event(events[n]);
+			++n;
+		}
+		uint32_t j1 = nframes;
+		if (n < nevents && events[n].frame < noffset + nframes)
+			j1 = events[n].frame - noffset;
+		if (!process_voices(outs, j0, j1 - j0))
+			sfxs_silent = false;
+		j0 = j1;
+	}
+
+	// late events (past the block end)
+	while (n < nevents) {
+		process_event(events[n]);
+		++n;
+	}
+
+	// chorus
+	if (m_nchannels > 1) {
+		sfxs_silent = m_chorus.process(m_sfxs[0], m_sfxs[1], nframes, *m_cho.wet,
+			*m_cho.delay, *m_cho.feedb, *m_cho.rate, *m_cho.mod, sfxs_silent);
+	}
+
+	// effects (per channel, in parallel when multi-channel)
+	m_fx_nframes = nframes;
+	m_fx_silent0 = sfxs_silent;
+	if (m_fx_pool) {
+		m_fx_pool->run(&m_fx_job, m_nchannels);
+	} else {
+		for (k = 0; k < m_nchannels; ++k)
+			processEffects(k);
+	}
+
+	// barrier: all channels done
+	bool fx_silent = true;
+	bool fx_sync = false;
+	for (k = 0; k < m_nchannels; ++k) {
+		if (m_delay[k].sync_request())
+			fx_sync = true;
+		// any channel
+		fx_silent = fx_silent && m_fx_silent[k];
+	}
+	sfxs_silent = fx_silent;
+
+	// reverb (convolution, when an impulse response is loaded)
+	if (m_nchannels > 1) {
+		if (m_convolver.sync()) {
+			sfxs_silent = m_convolver.process(m_sfxs[0], m_sfxs[1], nframes,
+				*m_rev.wet, sfxs_silent);
+		} else {
+			sfxs_silent = m_reverb.process(m_sfxs[0], m_sfxs[1], nframes, *m_rev.wet,
+				*m_rev.feedb, *m_rev.room, *m_rev.damp, *m_rev.width, sfxs_silent);
+		}
+	}
+
+	if (m_convolver.sync_request())
+		fx_sync = true;
+
+	// delay and convolver buffers (re)allocation, off real-time
+	if (fx_sync)
+		m_fx_sched.schedule();
+
+	// lookahead limiter (re)started clean.
+	const bool limiter = (int(*m_dyn.limiter) > 0);
+	const bool limiter_active = (limiter && m_limiter_lookahead);
+	if (limiter_active && !m_limiter_active) {
+		for (k = 0; k < m_nchannels; ++k)
+			m_limiter[k].reset();
+	}
+	m_limiter_active = limiter_active;
+
+	// output mix-down
+	for (k = 0; k < m_nchannels; ++k) {
+		uint32_t n;
+		float *sfx = m_sfxs[k];
+		float *out = outs[k];
+		bool silent = sfxs_silent;
+		// compressor
+		if (int(*m_dyn.compress) > 0)
+			silent = m_comp[k].process(sfx, nframes, silent);
+		// lookahead limiter: on the whole (dry+wet) output,
+		// always, as its delay line must be kept running...
+		if (limiter_active) {
+			if (!silent) {
+				for (n = 0; n < nframes; ++n)
+					out[n] += sfx[n];
+			}
+			m_limiter[k].process(out, nframes);
+			continue;
+		}
+		// nothing else to do, when silent
+		if (silent)
+			continue;
+		// limiter and mix-down
+		if (limiter) {
+			for (n = 0; n < nframes; ++n)
+				out[n] += samplv1_sigmoid(sfx[n]);
+		} else {
+			for (n = 0; n < nframes; ++n)
+				out[n] += sfx[n];
+		}
+	}
+
+	// post-processing
+	m_dca1.volume.tick(nframes);
+	m_out1.width.tick(nframes);
+	m_out1.panning.tick(nframes);
+	m_out1.volume.tick(nframes);
+
+	m_wid1.process(nframes);
+	m_pan1.process(nframes);
+	m_vol1.process(nframes);
+
+	m_controls.process(nframes);
+}
+
+
+// render all playing voices, for a block segment;
+// returns whether fx-sends are silent.
+
+bool samplv1_impl::process_voices (
+	float **outs, uint32_t noffset, uint32_t nframes )
+{
+	float *v_outs[m_nchannels];
+	float *v_sfxs[m_nchannels];
+
+	uint16_t k;
+
 	// channel indexes
 
 	const uint16_t k11 = 0;
@@ -2253,6 +3247,8 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 	const float lfo1_freq = (lfo1_enabled
 		? get_bpm(*m_lfo1.bpm) / (60.01f - *m_lfo1.rate * 60.0f) : 0.0f);
 
+	const bool lfo1_global = (lfo1_enabled && *m_lfo1.global > 0.0f);
+
 	const float modwheel1 = (lfo1_enabled
 		? m_ctl1.modwheel + PITCH_SCALE * *m_lfo1.pitch : 0.0f);
 
@@ -2260,20 +3256,16 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 
 	const float fxsend1 = *m_out1.fxsend * *m_out1.fxsend;
 
-	if (m_gen1.sample0 != *m_gen1.sample) {
-		m_gen1.sample0  = *m_gen1.sample;
-		gen1_sample.next()->reset(samplv1_freq(m_gen1.sample0));
-	}
+	// global lfo, rendered once for all voices (no sweep)
 
-	if (m_gen1.envtime0 != *m_gen1.envtime) {
-		m_gen1.envtime0  = *m_gen1.envtime;
-		updateEnvTimes();
+	if (lfo1_global) {
+		for (uint32_t j = 0; j < nframes; ++j)
+			m_lfo1_buf[noffset + j] = m_lfo1_osc.sample(lfo1_freq);
 	}
 
-	if (lfo1_enabled) {
-		lfo1_wave.reset_test(
-			samplv1_wave::Shape(*m_lfo1.shape), *m_lfo1.width);
-	}
+	// fx-send silence (no voices or no send)
+
+	const bool sfxs_silent = (m_play_list.next() == nullptr || fxsend1 < 1E-9f);
 
 	// per voice
 
@@ -2286,8 +3278,8 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		// output buffers
 
 		for (k = 0; k < m_nchannels; ++k) {
-			v_outs[k] = outs[k];
-			v_sfxs[k] = m_sfxs[k];
+			v_outs[k] = outs[k] + noffset;
+			v_sfxs[k] = m_sfxs[k] + noffset;
 		}
 
 		uint32_t nblock = nframes;
@@ -2295,6 +3287,8 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		while (nblock > 0) {
 
 			uint32_t ngen = nblock;
+			if (ngen > MAX_ENV_FRAMES)
+				ngen = MAX_ENV_FRAMES;
 
 			// process envelope stages
 
@@ -2305,6 +3299,22 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 			if (pv->lfo1_env.running && pv->lfo1_env.frames < ngen)
 				ngen = pv->lfo1_env.frames;
 
+			// block offset (global ramps)
+
+			const uint32_t j0 = noffset + nframes - nblock;
+
+			// render envelope blocks
+
+			float dca1_env[MAX_ENV_FRAMES];
+			float dcf1_env[MAX_ENV_FRAMES];
+			float lfo1_env[MAX_ENV_FRAMES];
+
+			pv->dca1_env.render(dca1_env, ngen);
+			if (dcf1_enabled)
+				pv->dcf1_env.render(dcf1_env, ngen);
+			if (lfo1_enabled)
+				pv->lfo1_env.render(lfo1_env, ngen);
+
 			for (uint32_t j = 0; j < ngen; ++j) {
 
 				// velocities
@@ -2314,70 +3324,53 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 
 				// generators
 
-				const float lfo1_env
-					= (lfo1_enabled ? pv->lfo1_env.tick() : 0.0f);
-				const float lfo1
-					= (lfo1_enabled ? pv->lfo1_sample * lfo1_env : 0.0f);
+				const float lfo1 = (lfo1_enabled ? lfo1_env[j]
+					* (lfo1_global ? m_lfo1_buf[j0 + j] : pv->lfo1_sample)
+					: 0.0f);
 
 				pv->gen1.next(pv->gen1_freq
-					* (m_ctl1.pitchbend + modwheel1 * lfo1)
+					* (m_ctl1.pitchbend * pv->gen1_bend + modwheel1 * lfo1)
 					+ pv->gen1_glide.tick());
 
 				float gen1 = pv->gen1.value(k11);
 				float gen2 = pv->gen1.value(k12);
 
-				if (lfo1_enabled) {
+				if (lfo1_enabled && !lfo1_global) {
 					pv->lfo1_sample = pv->lfo1.sample(lfo1_freq
-						* (1.0f + SWEEP_SCALE * *m_lfo1.sweep * lfo1_env));
+						* (1.0f + SWEEP_SCALE * *m_lfo1.sweep * lfo1_env[j]));
 				}
 
 				// filters
 
 				if (dcf1_enabled) {
 					const float env1 = 0.5f
-						* (1.0f + *m_dcf1.envelope * pv->dcf1_env.tick());
+						* (1.0f + *m_dcf1.envelope * dcf1_env[j]);
 					const float cutoff1 = samplv1_sigmoid_1(*m_dcf1.cutoff
 						* env1 * (1.0f + *m_lfo1.cutoff * lfo1));
 					const float reso1 = samplv1_sigmoid_1(*m_dcf1.reso
 						* env1 * (1.0f + *m_lfo1.reso * lfo1));
-					switch (int(*m_dcf1.slope)) {
-					case 3: // Formant
-						gen1 = pv->dcf17.output(gen1, cutoff1, reso1);
-						gen2 = pv->dcf18.output(gen2, cutoff1, reso1);
-						break;
-					case 2: // Biquad
-						gen1 = pv->dcf15.output(gen1, cutoff1, reso1);
-						gen2 = pv->dcf16.output(gen2, cutoff1, reso1);
-						break;
-					case 1: // 24db/octave
-						gen1 = pv->dcf13.output(gen1, cutoff1, reso1);
-						gen2 = pv->dcf14.output(gen2, cutoff1, reso1);
-						break;
-					case 0: // 12db/octave
-					default:
-						gen1 = pv->dcf11.output(gen1, cutoff1, reso1);
-						gen2 = pv->dcf12.output(gen2, cutoff1, reso1);
-						break;
-					}
+					pv->dcf1.output(gen1, gen2,
+						int(*m_dcf1.slope), cutoff1, reso1,
+						int(*m_dcf1.oversample));
 				}
 
 				// volumes
 
-				const float wid1 = m_wid1.value(j);
+				const float wid1 = m_wid1.value(j0 + j);
 				const float mid1 = 0.5f * (gen1 + gen2);
 				const float sid1 = 0.5f * (gen1 - gen2);
-				const float vol1 = vel1 * m_vol1.value(j)
-					* pv->dca1_env.tick()
+				const float vol1 = vel1 * m_vol1.value(j0 + j)
+					* dca1_env[j]
 					* pv->out1_vol.value(j);
 
 				// outputs
 
 				const float out1 = vol1 * (mid1 + sid1 * wid1)
 					* pv->out1_pan.value(j, 0)
-					* m_pan1.value(j, 0);
+					* m_pan1.value(j0 + j, 0);
 				const float out2 = vol1 * (mid1 - sid1 * wid1)
 					* pv->out1_pan.value(j, 1)
-					* m_pan1.value(j, 1);
+					* m_pan1.value(j0 + j, 1);
 
 				for (k = 0; k < m_nchannels; ++k) {
 					const float dry = (k & 1 ? out2 : out1);
@@ -2423,63 +3416,7 @@ void samplv1_impl::process ( float **ins, float **outs, uint32_t nframes )
 		pv = pv_next;
 	}
 
-	// chorus
-	if (m_nchannels > 1) {
-		m_chorus.process(m_sfxs[0], m_sfxs[1], nframes, *m_cho.wet,
-			*m_cho.delay, *m_cho.feedb, *m_cho.rate, *m_cho.mod);
-	}
-
-	// effects
-	for (k = 0; k < m_nchannels; ++k) {
-		float *in = m_sfxs[k];
-		// flanger
-		m_flanger[k].process(in, nframes, *m_fla.wet,
-			*m_fla.delay, *m_fla.feedb, *m_fla.daft * float(k));
-		// phaser
-		m_phaser[k].process(in, nframes, *m_pha.wet,
-			*m_pha.rate, *m_pha.feedb, *m_pha.depth, *m_pha.daft * float(k));
-		// delay
-		m_delay[k].process(in, nframes, *m_del.wet,
-			*m_del.delay, *m_del.feedb, get_bpm(*m_del.bpm));
-	}
-
-	// reverb
-	if (m_nchannels > 1) {
-		m_reverb.process(m_sfxs[0], m_sfxs[1], nframes, *m_rev.wet,
-			*m_rev.feedb, *m_rev.room, *m_rev.damp, *m_rev.width);
-	}
-
-	// output mix-down
-	for (k = 0; k < m_nchannels; ++k) {
-		uint32_t n;
-		float *sfx = m_sfxs[k];
-		// compressor
-		if (int(*m_dyn.compress) > 0)
-			m_comp[k].process(sfx, nframes);
-		// limiter
-		if (int(*m_dyn.limiter) > 0) {
-			float *p = sfx;
-			float *q = sfx;
-			for (n = 0; n < nframes; ++n)
-				*q++ = samplv1_sigmoid(*p++);
-		}
-		// mix-down
-		float *out = outs[k];
-		for (n = 0; n < nframes; ++n)
-			*out++ += *sfx++;
-	}
-
-	// post-processing
-	m_dca1.volume.tick(nframes);
-	m_out1.width.tick(nframes);
-	m_out1.panning.tick(nframes);
-	m_out1.volume.tick(nframes);
-
-	m_wid1.process(nframes);
-	m_pan1.process(nframes);
-	m_vol1.process(nframes);
-
-	m_controls.process(nframes);
+	return sfxs_silent;
 }
 
 
@@ -2636,6 +3573,12 @@ void samplv1::setSampleFile ( const char *pszSampleFile, uint16_t iOctaves, bool
 }
 
 
+void samplv1::cancelSampleFile (void)
+{
+	m_pImpl->cancelSampleFile();
+}
+
+
 const char *samplv1::sampleFile (void) const
 {
 	return m_pImpl->sampleFile();
@@ -2837,14 +3780,35 @@ void samplv1::process_midi ( uint8_t *data, uint32_t size )
 }
 
 
+void samplv1::process_ump ( uint8_t *data, uint32_t size )
+{
+	m_pImpl->process_ump(data, size);
+}
+
+
 void samplv1::process ( float **ins, float **outs, uint32_t nframes )
 {
+	samplv1_ftz ftz(m_pImpl->isFlushToZero());
+
 	m_pImpl->process(ins, outs, nframes);
 
 	m_pImpl->sampleReverseTest();
 }
 
 
+// process with an event-list: voices are split at event offsets,
+// while effects and post-processing are run once per block.
+void samplv1::process ( float **ins, float **outs, uint32_t nframes,
+	const samplv1_event *events, uint32_t nevents )
+{
+	samplv1_ftz ftz(m_pImpl->isFlushToZero());
+
+	m_pImpl->process(ins, outs, nframes, events, nevents);
+
+	m_pImpl->sampleReverseTest();
+}
+
+
 // controllers accessor
 
 samplv1_controls *samplv1::controls (void) const
@@ -2976,4 +3940,47 @@ void samplv1::resetTuning (void)
 }
 
 
+// Flush-to-zero/denormals-are-zero mode
+void samplv1::setFlushToZero ( bool enabled )
+{
+	m_pImpl->setFlushToZero(enabled);
+}
+
+bool samplv1::isFlushToZero (void) const
+{
+	return m_pImpl->isFlushToZero();
+}
+
+
+// Lookahead true-peak limiter mode
+void samplv1::setLimiterLookahead ( bool enabled )
+{
+	m_pImpl->setLimiterLookahead(enabled);
+}
+
+bool samplv1::isLimiterLookahead (void) const
+{
+	return m_pImpl->isLimiterLookahead();
+}
+
+
+// Processing latency (frames)
+uint32_t samplv1::latency (void) const
+{
+	return m_pImpl->latency();
+}
+
+
+// Convolution reverb impulse response file
+void samplv1::setReverbFile ( const char *pszReverbFile )
+{
+	m_pImpl->setReverbFile(pszReverbFile);
+}
+
+const char *samplv1::reverbFile (void) const
+{
+	return m_pImpl->reverbFile();
+}
+
+
 // end of samplv1.cpp
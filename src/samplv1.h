@@ -35,6 +35,19 @@ class samplv1_controls;
 class samplv1_programs;
 
 
+//-------------------------------------------------------------------------
+// samplv1_event - timestamped MIDI event (process event-list item).
+//
+
+struct samplv1_event
+{
+	uint32_t frame;		// offset in current block (frames).
+	uint32_t size;		// MIDI data size (bytes).
+	uint8_t *data;		// MIDI data.
+	bool     ump;		// MIDI 2.0 UMP data (32-bit words).
+};
+
+
 //-------------------------------------------------------------------------
 // samplv1 - decl.
 //
@@ -54,6 +67,7 @@ public:
 	float sampleRate() const;
 
 	void setSampleFile(const char *pszSampleFile, uint16_t iOctaves, bool bSync = false);
+	void cancelSampleFile();
 	const char *sampleFile() const;
 	uint16_t octaves() const;
 
@@ -179,6 +193,9 @@ public:
 		KEY1_LOW,
 		KEY1_HIGH,
 
+		DCF1_OVERSAMPLE,
+		LFO1_GLOBAL,
+
 		NUM_PARAMS
 	};
 
@@ -197,7 +214,10 @@ public:
 	samplv1_programs *programs() const;
 
 	void process_midi(uint8_t *data, uint32_t size);
+	void process_ump(uint8_t *data, uint32_t size);
 	void process(float **ins, float **outs, uint32_t nframes);
+	void process(float **ins, float **outs, uint32_t nframes,
+		const samplv1_event *events, uint32_t nevents);
 
 	void sampleOffsetLoopTest();
 
@@ -237,6 +257,17 @@ public:
 
 	virtual void updateTuning() = 0;
 
+	void setFlushToZero(bool enabled);
+	bool isFlushToZero() const;
+
+	void setLimiterLookahead(bool enabled);
+	bool isLimiterLookahead() const;
+
+	uint32_t latency() const;
+
+	void setReverbFile(const char *pszReverbFile);
+	const char *reverbFile() const;
+
 private:
 
 	samplv1_impl *m_pImpl;
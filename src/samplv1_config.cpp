@@ -424,6 +424,7 @@ QString samplv1_config::controlPrefix (void)
 
 void samplv1_config::loadControls ( samplv1_controls *pControls )
 {
+	pControls->begin_update();
 	pControls->clear();
 
 	QSettings::beginGroup(controlsGroup());
@@ -453,6 +454,7 @@ void samplv1_config::loadControls ( samplv1_controls *pControls )
 
 	QSettings::endGroup();
 
+	pControls->end_update();
 	pControls->enabled(bControlsEnabled);
 }
 
@@ -513,6 +515,8 @@ void samplv1_config::load (void)
 	iFrameTimeFormat = QSettings::value("/FrameTimeFormat", 0).toInt();
 	fRandomizePercent = QSettings::value("/RandomizePercent", 20.0f).toFloat();
 	iPitchShiftType  = QSettings::value("/PitchShiftType", 0).toInt();
+	bFlushToZero = QSettings::value("/FlushToZero", true).toBool();
+	bLimiterLookahead = QSettings::value("/LimiterLookahead", false).toBool();
 	bControlsEnabled = QSettings::value("/ControlsEnabled", false).toBool();
 	bProgramsEnabled = QSettings::value("/ProgramsEnabled", false).toBool();
 	QSettings::endGroup();
@@ -561,6 +565,8 @@ void samplv1_config::save (void)
 	QSettings::setValue("/FrameTimeFormat", iFrameTimeFormat);
 	QSettings::setValue("/RandomizePercent", fRandomizePercent);
 	QSettings::setValue("/PitchShiftType", iPitchShiftType);
+	QSettings::setValue("/FlushToZero", bFlushToZero);
+	QSettings::setValue("/LimiterLookahead", bLimiterLookahead);
 	QSettings::setValue("/ControlsEnabled", bControlsEnabled);
 	QSettings::setValue("/ProgramsEnabled", bProgramsEnabled);
 	QSettings::endGroup();
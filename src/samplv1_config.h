@@ -80,6 +80,12 @@ public:
 	// Pitch-shit algorithm.
 	int iPitchShiftType;
 
+	// Flush-to-zero/denormals-are-zero mode.
+	bool bFlushToZero;
+
+	// Lookahead true-peak limiter mode.
+	bool bLimiterLookahead;
+
 	// Micro-tuning options.
 	bool    bTuningEnabled;
 	float   fTuningRefPitch;
@@ -566,6 +566,180 @@ private:
 };
 
 
+//---------------------------------------------------------------------
+// samplv1_controls::Table - real-time controller table.
+//
+// CC and CC14 controllers are direct-indexed by channel and param;
+// (N)RPN params are 14-bit wide, so these are kept sorted instead
+// and binary searched. Built off the real-time thread, from map;
+// the real-time (catch-up) state is carried over from the previous
+// table on pick up, unless there was a reset in-between.
+//
+
+class samplv1_controls::Table
+{
+public:
+
+	Table(const samplv1_controls::Map& map, unsigned int reset)
+		: m_nxrpns(0), m_xrpn_keys(nullptr), m_xrpn_slots(nullptr),
+			m_ndata(0), m_reset(reset)
+	{
+		unsigned short ch, i;
+		for (ch = 0; ch < NUM_CHANNELS; ++ch) {
+			for (i = 0; i < NUM_CC; ++i)
+				m_cc[ch][i] = -1;
+			for (i = 0; i < NUM_CC14; ++i)
+				m_cc14[ch][i] = -1;
+		}
+
+		const int ndata = map.size();
+		m_data = new samplv1_controls::Data [ndata > 0 ? ndata : 1];
+		m_keys = new samplv1_controls::Key [ndata > 0 ? ndata : 1];
+		m_xrpn_keys  = new unsigned int [ndata > 0 ? ndata : 1];
+		m_xrpn_slots = new int [ndata > 0 ? ndata : 1];
+
+		// map is ordered by status, then param: so are xrpn keys.
+		int slot = 0;
+		samplv1_controls::Map::ConstIterator iter = map.constBegin();
+		const samplv1_controls::Map::ConstIterator& iter_end = map.constEnd();
+		for ( ; iter != iter_end; ++iter) {
+			const samplv1_controls::Key& key = iter.key();
+			const unsigned short channel = key.channel();
+			if (channel >= NUM_CHANNELS)
+				continue;
+			switch (key.type()) {
+			case samplv1_controls::CC:
+				if (key.param >= NUM_CC)
+					continue;
+				m_cc[channel][key.param] = slot;
+				break;
+			case samplv1_controls::CC14:
+				if (key.param >= NUM_CC14)
+					continue;
+				m_cc14[channel][key.param] = slot;
+				break;
+			case samplv1_controls::RPN:
+			case samplv1_controls::NRPN:
+				m_xrpn_keys[m_nxrpns] = xrpn_key(key);
+				m_xrpn_slots[m_nxrpns] = slot;
+				++m_nxrpns;
+				break;
+			default:
+				continue;
+			}
+			m_keys[slot] = key;
+			m_data[slot++] = iter.value();
+		}
+
+		m_ndata = slot;
+	}
+
+	~Table()
+	{
+		delete [] m_xrpn_slots;
+		delete [] m_xrpn_keys;
+		delete [] m_keys;
+		delete [] m_data;
+	}
+
+	// reset generation (non-real-time state reset count).
+	unsigned int reset() const
+		{ return m_reset; }
+
+	// carry over the real-time state of the same assignments (real-time).
+	void carry(Table& table)
+	{
+		for (int slot = 0; slot < m_ndata; ++slot) {
+			samplv1_controls::Data& data = m_data[slot];
+			const samplv1_controls::Data *pData = table.find(m_keys[slot]);
+			if (pData && pData->index == data.index) {
+				data.val  = pData->val;
+				data.sync = pData->sync;
+			}
+		}
+	}
+
+	// real-time lookup (null if not assigned).
+	samplv1_controls::Data *find(const samplv1_controls::Key& key)
+	{
+		const unsigned short channel = key.channel();
+		if (channel >= NUM_CHANNELS)
+			return nullptr;
+
+		int slot = -1;
+
+		switch (key.type()) {
+		case samplv1_controls::CC:
+			if (key.param < NUM_CC)
+				slot = m_cc[channel][key.param];
+			break;
+		case samplv1_controls::CC14:
+			if (key.param < NUM_CC14)
+				slot = m_cc14[channel][key.param];
+			break;
+		case samplv1_controls::RPN:
+		case samplv1_controls::NRPN: {
+			const unsigned int xkey = xrpn_key(key);
+			unsigned int lo = 0, hi = m_nxrpns;
+			while (lo < hi) {
+				const unsigned int mid = (lo + hi) >> 1;
+				if (m_xrpn_keys[mid] < xkey)
+					lo = mid + 1;
+				else
+					hi = mid;
+			}
+			if (lo < m_nxrpns && m_xrpn_keys[lo] == xkey)
+				slot = m_xrpn_slots[lo];
+			break;
+		}
+		default:
+			break;
+		}
+
+		return (slot < 0 ? nullptr : &m_data[slot]);
+	}
+
+	// real-time lookup, or else on channel 0 (Auto).
+	samplv1_controls::Data *find_any(const samplv1_controls::Key& key)
+	{
+		samplv1_controls::Data *pData = find(key);
+		if (pData == nullptr && key.channel() > 0) {
+			samplv1_controls::Key key0(key);
+			key0.status = key.type(); // channel=0 (Auto)
+			pData = find(key0);
+		}
+		return pData;
+	}
+
+protected:
+
+	static unsigned int xrpn_key(const samplv1_controls::Key& key)
+		{ return ((unsigned int) key.status << 16) | key.param; }
+
+private:
+
+	// channels: 0=Auto, 1..16.
+	static const unsigned short NUM_CHANNELS = 17;
+
+	static const unsigned short NUM_CC   = 0x80;
+	static const unsigned short NUM_CC14 = CC14_MSB_MAX;
+
+	int m_cc[NUM_CHANNELS][NUM_CC];
+	int m_cc14[NUM_CHANNELS][NUM_CC14];
+
+	unsigned int  m_nxrpns;
+	unsigned int *m_xrpn_keys;
+	int          *m_xrpn_slots;
+
+	samplv1_controls::Key  *m_keys;
+	samplv1_controls::Data *m_data;
+
+	int m_ndata;
+
+	unsigned int m_reset;
+};
+
+
 //---------------------------------------------------------------------
 // samplv1_controls - impl.
 //
@@ -573,17 +747,103 @@ private:
 samplv1_controls::samplv1_controls ( samplv1 *pSampl )
 	: m_pImpl(new samplv1_controls::Impl()), m_enabled(false),
 		m_sched_in(pSampl), m_sched_out(pSampl),
-		m_timeout(0), m_timein(0)
+		m_update(0), m_reset(0), m_table(nullptr), m_table_next(nullptr),
+		m_table_free(nullptr), m_timeout(0), m_timein(0)
 {
 }
 
 
 samplv1_controls::~samplv1_controls (void)
 {
+	delete m_table_free.exchange(nullptr);
+	delete m_table_next.exchange(nullptr);
+	delete m_table;
+
 	delete m_pImpl;
 }
 
 
+// controller map methods (non-real-time).
+void samplv1_controls::add_control ( const Key& key, const Data& data )
+{
+	m_map.insert(key, data);
+
+	post_table();
+}
+
+
+void samplv1_controls::remove_control ( const Key& key )
+{
+	m_map.remove(key);
+
+	post_table();
+}
+
+
+void samplv1_controls::clear (void)
+{
+	m_map.clear();
+
+	post_table();
+}
+
+
+// controller map batch updates: table posted once, at last.
+void samplv1_controls::begin_update (void)
+{
+	++m_update;
+}
+
+
+void samplv1_controls::end_update (void)
+{
+	if (m_update > 0 && --m_update == 0)
+		post_table();
+}
+
+
+// post a new controller table, from current map.
+void samplv1_controls::post_table (void)
+{
+	if (m_update > 0)
+		return;
+
+	sync_free();
+
+	// replace any previous one never picked up...
+	delete m_table_next.exchange(
+		new Table(m_map, m_reset), std::memory_order_acq_rel);
+}
+
+
+// free whatever the real-time thread left behind.
+void samplv1_controls::sync_free (void)
+{
+	delete m_table_free.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+
+// real-time: pick up any pending controller table.
+samplv1_controls::Table *samplv1_controls::sync_table (void)
+{
+	// only when the previous one has been freed...
+	if (m_table_free.load(std::memory_order_acquire) == nullptr) {
+		Table *table = m_table_next.exchange(nullptr, std::memory_order_acq_rel);
+		if (table) {
+			if (m_table) {
+				// keep catching-up where it was, unless reset.
+				if (m_table->reset() == table->reset())
+					table->carry(*m_table);
+				m_table_free.store(m_table, std::memory_order_release);
+			}
+			m_table = table;
+		}
+	}
+
+	return m_table;
+}
+
+
 // controller queue methods.
 void samplv1_controls::process_enqueue (
 	unsigned short channel, unsigned short param, unsigned short value )
@@ -618,29 +878,63 @@ void samplv1_controls::process_dequeue (void)
 }
 
 
+// high-resolution controller event, value in [0,1].
+void samplv1_controls::process_value ( Type ctype,
+	unsigned short channel, unsigned short param, float fValue )
+{
+	if (!enabled())
+		return;
+
+	Key key;
+
+	key.status = ctype | (channel & 0x1f);
+	key.param = param;
+
+	// a high-resolution CC is good for a 14-bit (CC14) assignment
+	// of the same (MSB) controller too, when not assigned as such.
+	if (ctype == CC && param > CC14_MSB_MIN && param < CC14_MSB_MAX) {
+		Table *table = sync_table();
+		if (table && table->find_any(key) == nullptr) {
+			Key key14;
+			key14.status = CC14 | (channel & 0x1f);
+			key14.param = param;
+			if (table->find_any(key14))
+				key = key14;
+		}
+	}
+
+	process_event(key, fValue);
+}
+
+
 // controller action.
 void samplv1_controls::process_event ( const Event& event )
 {
-	Key key(event.key);
+	// process controller event...
+	float fScale = float(event.value) / 127.0f;
+	if (event.key.type() != CC)
+		fScale /= 127.0f;
+
+	process_event(event.key, fScale);
+}
+
+
+void samplv1_controls::process_event ( const Key& event_key, float fScale )
+{
+	Key key(event_key);
 
 	m_sched_in.schedule_key(key);
 
-	const Map::Iterator& iter_end = m_map.end();
-	Map::Iterator iter = m_map.find(key);
-	if (iter == iter_end && key.channel() > 0) {
-		key.status = key.type(); // channel=0 (Auto)
-		iter = m_map.find(key);
-	}
-	if (iter == iter_end)
+	Table *table = sync_table();
+	if (table == nullptr)
 		return;
 
-	// reference to payload...
-	Data& data = iter.value();
+	Data *pData = table->find_any(key);
+	if (pData == nullptr)
+		return;
 
-	// process controller event...
-	float fScale = float(event.value) / 127.0f;
-	if (key.type() != CC)
-		fScale /= 127.0f;
+	// reference to payload...
+	Data& data = *pData;
 
 	if (fScale > 1.0f)
 		fScale = 1.0f;
@@ -714,6 +1008,10 @@ void samplv1_controls::reset (void)
 			m_sched_in.instance()->paramValue(index));
 		data.sync = false;
 	}
+
+	++m_reset;
+
+	post_table();
 }
 
 
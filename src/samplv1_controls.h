@@ -27,6 +27,8 @@
 
 #include <QMap>
 
+#include <atomic>
+
 
 //-------------------------------------------------------------------------
 // samplv1_controls - Controller processs class.
@@ -109,17 +111,20 @@ public:
 		unsigned short value;
 	};
 
-	// controller map methods.
+	// controller map methods (non-real-time).
 	const Map& map() const { return m_map; }
 
 	int find_control(const Key& key) const
 		{ return m_map.value(key).index; }
-	void add_control(const Key& key, const Data& data)
-		{ m_map.insert(key, data); }
-	void remove_control(const Key& key)
-		{ m_map.remove(key); }
+	void add_control(const Key& key, const Data& data);
+	void remove_control(const Key& key);
+
+	void clear();
 
-	void clear() { m_map.clear(); }
+	// controller map batch updates (non-real-time):
+	// the real-time table gets rebuilt once, at last.
+	void begin_update();
+	void end_update();
 
 	// reset all controllers.
 	void reset();
@@ -132,6 +137,13 @@ public:
 
 	void process_dequeue();
 
+	// high-resolution controller event (eg. MIDI 2.0),
+	// value in [0,1], no (N)RPN/CC14 reassembly involved.
+	void process_value(Type ctype,
+		unsigned short channel,
+		unsigned short param,
+		float fValue);
+
 	// process timer counter.
 	void process(unsigned int nframes);
 
@@ -146,6 +158,19 @@ protected:
 
 	// controller action.
 	void process_event(const Event& event);
+	void process_event(const Key& key, float fScale);
+
+	// real-time controller table (flat, direct-indexed).
+	class Table;
+
+	// post a new controller table, from current map.
+	void post_table();
+
+	// free whatever the real-time thread left behind.
+	void sync_free();
+
+	// real-time: pick up any pending controller table.
+	Table *sync_table();
 
 	// input controller scheduled events (learn)
 	class SchedIn : public samplv1_sched
@@ -218,9 +243,21 @@ private:
 	SchedIn  m_sched_in;
 	SchedOut m_sched_out;
 
-	// controllers map.
+	// controllers map (non-real-time).
 	Map m_map;
 
+	// batch update nesting level.
+	int m_update;
+
+	// reset generation (non-real-time).
+	unsigned int m_reset;
+
+	// current (real-time), next and garbage controller tables.
+	Table *m_table;
+
+	std::atomic<Table *> m_table_next;
+	std::atomic<Table *> m_table_free;
+
 	// frame timers.
 	unsigned int m_timeout;
 	unsigned int m_timein;
@@ -0,0 +1,1075 @@
+// samplv1_convolver.cpp
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "samplv1_convolver.h"
+#include "samplv1_sched.h"
+
+#include <sndfile.h>
+
+#include <cstdlib>
+#include <cstring>
+
+#include <cmath>
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_file - impulse response file data.
+//
+// Kept as loaded (interleaved, original sample rate), so that the
+// impulse response can be rebuilt without any file I/O whenever the
+// sample rate or buffer size changes.
+//
+
+class samplv1_convolver_file
+{
+public:
+
+	// ctor.
+	samplv1_convolver_file(const char *filename)
+		: data(nullptr), nchannels(0), nframes(0), srate(0.0f)
+	{
+		SF_INFO info;
+		::memset(&info, 0, sizeof(info));
+
+		SNDFILE *file = ::sf_open(filename, SFM_READ, &info);
+		if (file == nullptr)
+			return;
+
+		if (info.channels < 1 || info.frames < 1 || info.samplerate < 1) {
+			::sf_close(file);
+			return;
+		}
+
+		uint32_t nmax = samplv1_convolver::MAX_SECS * uint32_t(info.samplerate);
+		if (nmax > uint32_t(info.frames))
+			nmax = uint32_t(info.frames);
+
+		nchannels = uint16_t(info.channels);
+		srate = float(info.samplerate);
+		data = new float [nchannels * nmax];
+
+		const int nread = ::sf_readf_float(file, data, nmax);
+		::sf_close(file);
+
+		if (nread > 0)
+			nframes = uint32_t(nread);
+	}
+
+	// dtor.
+	~samplv1_convolver_file()
+		{ if (data) delete [] data; }
+
+	// whether it's a valid impulse response.
+	bool isValid() const
+		{ return (nframes > 0); }
+
+	// instance variables.
+	float   *data;
+	uint16_t nchannels;
+	uint32_t nframes;
+	float    srate;
+};
+
+
+#ifdef CONFIG_FFTW3
+
+#include "samplv1_resampler.h"
+#include "samplv1_pshifter.h"
+#include "samplv1_sem.h"
+
+#include <fftw3.h>
+
+#include <QThread>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_part - uniformly partitioned convolution (decl).
+//
+// Overlap-save, frequency-domain delay line (FDL) of equally sized
+// partitions; each call takes nsize input frames and yields as many
+// output frames, with no latency other than the block itself.
+//
+
+class samplv1_convolver_part
+{
+public:
+
+	// ctor.
+	samplv1_convolver_part(uint32_t nsize, const float *h, uint32_t nframes);
+
+	// dtor.
+	~samplv1_convolver_part();
+
+	// reset state.
+	void reset();
+
+	// process one block (nsize frames).
+	void process(const float *in, float *out);
+
+private:
+
+	uint32_t m_nsize;
+	uint32_t m_nbins;
+	uint32_t m_nparts;
+	uint32_t m_ipart;
+
+	float *m_inp;
+	float *m_out;
+
+	fftwf_complex *m_spec;
+	fftwf_complex *m_hdl;
+	fftwf_complex *m_fdl;
+
+	fftwf_plan m_fplan;
+	fftwf_plan m_iplan;
+};
+
+
+// ctor.
+samplv1_convolver_part::samplv1_convolver_part (
+	uint32_t nsize, const float *h, uint32_t nframes )
+	: m_nsize(nsize), m_nbins(nsize + 1),
+		m_nparts((nframes + nsize - 1) / nsize), m_ipart(0)
+{
+	const uint32_t nsize2 = (m_nsize << 1);
+
+	m_inp = (float *) ::fftwf_malloc(nsize2 * sizeof(float));
+	m_out = (float *) ::fftwf_malloc(nsize2 * sizeof(float));
+
+	m_spec = (fftwf_complex *) ::fftwf_malloc(
+		m_nbins * sizeof(fftwf_complex));
+	m_hdl = (fftwf_complex *) ::fftwf_malloc(
+		m_nparts * m_nbins * sizeof(fftwf_complex));
+	m_fdl = (fftwf_complex *) ::fftwf_malloc(
+		m_nparts * m_nbins * sizeof(fftwf_complex));
+
+	{
+		samplv1_fftw_plan_lock lock;
+		m_fplan = ::fftwf_plan_dft_r2c_1d(nsize2, m_inp, m_spec, FFTW_ESTIMATE);
+		m_iplan = ::fftwf_plan_dft_c2r_1d(nsize2, m_spec, m_out, FFTW_ESTIMATE);
+	}
+
+	// partition spectra, inverse transform scaling included.
+	const float scale = 1.0f / float(nsize2);
+	for (uint32_t p = 0; p < m_nparts; ++p) {
+		const uint32_t offs = p * m_nsize;
+		const uint32_t n = (nframes - offs < m_nsize ? nframes - offs : m_nsize);
+		for (uint32_t i = 0; i < n; ++i)
+			m_inp[i] = scale * h[offs + i];
+		::memset(m_inp + n, 0, (nsize2 - n) * sizeof(float));
+		::fftwf_execute(m_fplan);
+		::memcpy(m_hdl + p * m_nbins, m_spec, m_nbins * sizeof(fftwf_complex));
+	}
+
+	reset();
+}
+
+
+// dtor.
+samplv1_convolver_part::~samplv1_convolver_part (void)
+{
+	{
+		samplv1_fftw_plan_lock lock;
+		::fftwf_destroy_plan(m_iplan);
+		::fftwf_destroy_plan(m_fplan);
+	}
+
+	::fftwf_free(m_fdl);
+	::fftwf_free(m_hdl);
+	::fftwf_free(m_spec);
+	::fftwf_free(m_out);
+	::fftwf_free(m_inp);
+}
+
+
+// reset state.
+void samplv1_convolver_part::reset (void)
+{
+	::memset(m_inp, 0, (m_nsize << 1) * sizeof(float));
+	::memset(m_fdl, 0, m_nparts * m_nbins * sizeof(fftwf_complex));
+
+	m_ipart = 0;
+}
+
+
+// process one block (nsize frames).
+void samplv1_convolver_part::process ( const float *in, float *out )
+{
+	// slide the input window by one block
+	::memcpy(m_inp, m_inp + m_nsize, m_nsize * sizeof(float));
+	::memcpy(m_inp + m_nsize, in, m_nsize * sizeof(float));
+
+	::fftwf_execute(m_fplan);
+
+	// newest spectrum goes first, older ones follow (circular)
+	m_ipart = (m_ipart > 0 ? m_ipart : m_nparts) - 1;
+	::memcpy(m_fdl + m_ipart * m_nbins, m_spec, m_nbins * sizeof(fftwf_complex));
+
+	// multiply-accumulate the whole delay line
+	const uint32_t nbins2 = (m_nbins << 1);
+	float *acc = &m_spec[0][0];
+	::memset(acc, 0, nbins2 * sizeof(float));
+
+	const float *h = &m_hdl[0][0];
+	const float *x = &m_fdl[0][0] + m_ipart * nbins2;
+	const float *x_end = &m_fdl[0][0] + m_nparts * nbins2;
+
+	for (uint32_t p = 0; p < m_nparts; ++p) {
+		for (uint32_t i = 0; i < nbins2; i += 2) {
+			acc[i + 0] += x[i] * h[i + 0] - x[i + 1] * h[i + 1];
+			acc[i + 1] += x[i] * h[i + 1] + x[i + 1] * h[i + 0];
+		}
+		h += nbins2;
+		x += nbins2;
+		if (x >= x_end)
+			x = &m_fdl[0][0];
+	}
+
+	::fftwf_execute(m_iplan);
+
+	// overlap-save: last half is the valid part
+	::memcpy(out, m_out + m_nsize, m_nsize * sizeof(float));
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_thread - tail worker thread (decl).
+//
+
+class samplv1_convolver_thread : public QThread
+{
+public:
+
+	// ctor.
+	samplv1_convolver_thread(samplv1_convolver_impl *impl);
+
+	// dtor.
+	~samplv1_convolver_thread();
+
+	// wake up (real-time).
+	void schedule();
+
+protected:
+
+	// main thread executive.
+	void run();
+
+	// follow the caller's scheduling policy, one priority below.
+	void update_sched();
+
+private:
+
+	// instance reference.
+	samplv1_convolver_impl *m_impl;
+
+	// whether the thread is logically running.
+	std::atomic<bool> m_running;
+
+	// caller's scheduling policy and priority.
+	std::atomic<int> m_caller_policy;
+	std::atomic<int> m_caller_priority;
+
+	// current scheduling policy and priority.
+	int m_policy;
+	int m_priority;
+
+	// thread synchronization object.
+	samplv1_sem m_sem;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_impl - impulse response instance (decl).
+//
+
+class samplv1_convolver_impl
+{
+public:
+
+	// ctor.
+	samplv1_convolver_impl(float srate = 0.0f,
+		uint32_t nperiod = 0, const samplv1_convolver_file *file = nullptr);
+
+	// dtor.
+	~samplv1_convolver_impl();
+
+	// whether it's a valid impulse response.
+	bool isValid() const
+		{ return (m_length > 0); }
+
+	// overall tail length (frames).
+	uint32_t tail() const
+		{ return m_length + m_toffs + m_tsize + m_hsize; }
+
+	// tail partition size (frames).
+	uint32_t tsize() const
+		{ return m_tsize; }
+
+	// tail partition size for some period (frames).
+	static uint32_t tail_size(uint32_t nperiod);
+
+	// reset state (real-time).
+	void reset();
+
+	// process (real-time).
+	void process(float *in0, float *in1, uint32_t nframes, float wet);
+
+	// process all pending tail blocks (worker).
+	void process_tail();
+
+protected:
+
+	// prepare impulse response from file data.
+	float **load(const samplv1_convolver_file *file, float srate, uint32_t& nframes);
+
+	// process one head block (real-time).
+	void process_head();
+
+private:
+
+	// number of tail blocks in flight (pow2).
+	static const uint32_t NUM_SLOTS = 4;
+	static const uint32_t SLOT_MASK = NUM_SLOTS - 1;
+
+	uint32_t m_length;
+
+	// partition sizes and tail offset.
+	uint32_t m_hsize;
+	uint32_t m_tsize;
+	uint32_t m_toffs;
+
+	// per channel partitioned convolutions.
+	samplv1_convolver_part *m_head[2];
+	samplv1_convolver_part *m_tail[2];
+
+	// head block input/output (real-time).
+	float *m_hinp[2];
+	float *m_hout[2];
+
+	uint32_t m_hpos;
+
+	// tail block input/output slots.
+	float *m_tinp[2];
+	float *m_tout[2];
+
+	// tail block input/output cursors (real-time).
+	uint32_t m_tpos;
+	uint32_t m_tblock;
+
+	uint32_t m_odelay;
+	uint32_t m_opos;
+	uint32_t m_oblock;
+	uint32_t m_omiss;
+
+	// tail blocks requested and done.
+	std::atomic<uint32_t> m_treq;
+	std::atomic<uint32_t> m_tdone;
+	std::atomic<bool> m_treset;
+
+	// tail block sequence (worker).
+	uint32_t m_tseq;
+
+	samplv1_convolver_thread *m_thread;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_thread - tail worker thread (impl).
+//
+
+// ctor.
+samplv1_convolver_thread::samplv1_convolver_thread (
+	samplv1_convolver_impl *impl ) : QThread(), m_impl(impl), m_running(true),
+		m_caller_policy(-1), m_caller_priority(0), m_policy(-1), m_priority(0)
+{
+}
+
+
+// dtor.
+samplv1_convolver_thread::~samplv1_convolver_thread (void)
+{
+	m_running = false;
+	m_sem.post();
+
+	wait();
+}
+
+
+// wake up (real-time).
+void samplv1_convolver_thread::schedule (void)
+{
+#if !defined(_WIN32)
+	int policy = SCHED_OTHER;
+	sched_param param;
+	if (::pthread_getschedparam(::pthread_self(), &policy, &param) == 0) {
+		m_caller_policy.store(policy, std::memory_order_relaxed);
+		m_caller_priority.store(param.sched_priority, std::memory_order_relaxed);
+	}
+#endif
+	m_sem.post();
+}
+
+
+// main thread executive.
+void samplv1_convolver_thread::run (void)
+{
+	for (;;) {
+		// wait for sync...
+		m_sem.wait();
+		if (!m_running)
+			break;
+		// do whatever we must, just behind the caller...
+		update_sched();
+		m_impl->process_tail();
+	}
+}
+
+
+// follow the caller's scheduling policy, one priority below.
+void samplv1_convolver_thread::update_sched (void)
+{
+#if !defined(_WIN32)
+	const int policy = m_caller_policy.load(std::memory_order_relaxed);
+	int priority = m_caller_priority.load(std::memory_order_relaxed);
+	if (policy == SCHED_FIFO || policy == SCHED_RR) {
+		const int priority_min = ::sched_get_priority_min(policy);
+		if (--priority < priority_min)
+			priority = priority_min;
+	}
+	if (policy < 0 || (policy == m_policy && priority == m_priority))
+		return;
+	m_policy = policy;
+	m_priority = priority;
+	sched_param param;
+	param.sched_priority = priority;
+	::pthread_setschedparam(::pthread_self(), policy, &param);
+#endif
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_impl - impulse response instance (impl).
+//
+
+// ctor.
+samplv1_convolver_impl::samplv1_convolver_impl (
+	float srate, uint32_t nperiod, const samplv1_convolver_file *file )
+	: m_length(0), m_hsize(samplv1_convolver::HEAD_SIZE),
+		m_tsize(0), m_toffs(0), m_hpos(0), m_tpos(0), m_tblock(0),
+		m_odelay(0), m_opos(0), m_oblock(0), m_omiss(0),
+		m_treq(0), m_tdone(0), m_treset(false), m_tseq(0),
+		m_thread(nullptr)
+{
+	for (uint16_t k = 0; k < 2; ++k) {
+		m_head[k] = nullptr;
+		m_tail[k] = nullptr;
+		m_hinp[k] = nullptr;
+		m_hout[k] = nullptr;
+		m_tinp[k] = nullptr;
+		m_tout[k] = nullptr;
+	}
+
+	if (file == nullptr || !file->isValid() || srate < 1.0f)
+		return;
+
+	uint32_t nframes = 0;
+	float **h = load(file, srate, nframes);
+	if (h == nullptr)
+		return;
+
+	// tail partitions as large as a whole period (at least),
+	// starting two of those ahead: leaves one full period for
+	// the worker to compute each tail block before it's due.
+	m_tsize = tail_size(nperiod);
+	m_toffs = (m_tsize << 1);
+
+	const uint32_t nhead = (nframes < m_toffs ? nframes : m_toffs);
+	for (uint16_t k = 0; k < 2; ++k) {
+		m_head[k] = new samplv1_convolver_part(m_hsize, h[k], nhead);
+		m_hinp[k] = new float [m_hsize];
+		m_hout[k] = new float [m_hsize];
+	}
+
+	if (nframes > m_toffs) {
+		const uint32_t ntail = nframes - m_toffs;
+		const uint32_t nslots = NUM_SLOTS * m_tsize;
+		for (uint16_t k = 0; k < 2; ++k) {
+			m_tail[k] = new samplv1_convolver_part(m_tsize, h[k] + m_toffs, ntail);
+			m_tinp[k] = new float [nslots];
+			m_tout[k] = new float [nslots];
+			::memset(m_tinp[k], 0, nslots * sizeof(float));
+			::memset(m_tout[k], 0, nslots * sizeof(float));
+		}
+	}
+
+	delete [] h[1];
+	delete [] h[0];
+	delete [] h;
+
+	m_length = nframes;
+
+	reset();
+
+	if (m_tail[0]) {
+		m_thread = new samplv1_convolver_thread(this);
+		m_thread->start(QThread::HighPriority);
+	}
+}
+
+
+// tail partition size for some period (frames).
+uint32_t samplv1_convolver_impl::tail_size ( uint32_t nperiod )
+{
+	uint32_t tsize = (samplv1_convolver::HEAD_SIZE << 4);
+	while (tsize < nperiod)
+		tsize <<= 1;
+	return tsize;
+}
+
+
+// dtor.
+samplv1_convolver_impl::~samplv1_convolver_impl (void)
+{
+	if (m_thread)
+		delete m_thread;
+
+	for (uint16_t k = 0; k < 2; ++k) {
+		if (m_tout[k])
+			delete [] m_tout[k];
+		if (m_tinp[k])
+			delete [] m_tinp[k];
+		if (m_tail[k])
+			delete m_tail[k];
+		if (m_hout[k])
+			delete [] m_hout[k];
+		if (m_hinp[k])
+			delete [] m_hinp[k];
+		if (m_head[k])
+			delete m_head[k];
+	}
+}
+
+
+// prepare impulse response from file data (stereo, resampled, normalized).
+float **samplv1_convolver_impl::load (
+	const samplv1_convolver_file *file, float srate, uint32_t& nframes )
+{
+	const uint16_t nchannels = file->nchannels;
+	const uint32_t ninp = file->nframes;
+
+	const uint32_t rinp = uint32_t(file->srate);
+	const uint32_t rout = uint32_t(srate);
+
+	float *buffer = nullptr;
+
+	nframes = 0;
+
+	// resample start...
+	if (rinp != rout) {
+		samplv1_resampler resampler;
+		const uint32_t nout = uint32_t(float(ninp) * srate / float(rinp));
+		const uint32_t FILTSIZE = 32; // resample medium quality
+		if (resampler.setup(rinp, rout, nchannels, FILTSIZE)) {
+			buffer = new float [nchannels * nout];
+			const uint32_t nlead = resampler.inpsize() / 2 - 1;
+			resampler.out_count = nout;
+			resampler.out_data  = buffer;
+			// pre-fill, compensates for the filter delay...
+			resampler.inp_count = nlead;
+			resampler.inp_data  = nullptr;
+			resampler.process();
+			resampler.inp_count = ninp;
+			resampler.inp_data  = file->data;
+			resampler.process();
+			// flush, gets the filter tail out...
+			resampler.inp_count = nlead + 1;
+			resampler.inp_data  = nullptr;
+			resampler.process();
+			nframes = (nout - resampler.out_count);
+		}
+	} else {
+		buffer = new float [nchannels * ninp];
+		::memcpy(buffer, file->data, nchannels * ninp * sizeof(float));
+		nframes = ninp;
+	}
+	// resample end.
+
+	if (nframes < 1) {
+		if (buffer)
+			delete [] buffer;
+		return nullptr;
+	}
+
+	// de-interleave (mono to both channels; stereo as is;
+	// more than two, just the first pair).
+	float **h = new float * [2];
+	for (uint16_t k = 0; k < 2; ++k) {
+		h[k] = new float [nframes];
+		const uint16_t c = (k < nchannels ? k : 0);
+		for (uint32_t j = 0; j < nframes; ++j)
+			h[k][j] = buffer[j * nchannels + c];
+	}
+
+	delete [] buffer;
+
+	// trim trailing silence (-100dB below peak).
+	float peak = 0.0f;
+	for (uint16_t k = 0; k < 2; ++k) {
+		for (uint32_t j = 0; j < nframes; ++j) {
+			const float v = ::fabsf(h[k][j]);
+			if (peak < v)
+				peak = v;
+		}
+	}
+
+	const float thresh = 1E-5f * peak;
+	uint32_t nlast = 0;
+	for (uint16_t k = 0; k < 2; ++k) {
+		for (uint32_t j = nframes; j > nlast; --j) {
+			if (::fabsf(h[k][j - 1]) > thresh) {
+				nlast = j;
+				break;
+			}
+		}
+	}
+
+	nframes = nlast;
+
+	if (nframes < 1) {
+		delete [] h[1];
+		delete [] h[0];
+		delete [] h;
+		return nullptr;
+	}
+
+	// normalize to unity energy (loudest channel).
+	float energy = 0.0f;
+	for (uint16_t k = 0; k < 2; ++k) {
+		float e = 0.0f;
+		for (uint32_t j = 0; j < nframes; ++j)
+			e += h[k][j] * h[k][j];
+		if (energy < e)
+			energy = e;
+	}
+
+	const float gain = 1.0f / ::sqrtf(energy);
+	for (uint16_t k = 0; k < 2; ++k) {
+		for (uint32_t j = 0; j < nframes; ++j)
+			h[k][j] *= gain;
+	}
+
+	return h;
+}
+
+
+// reset state (real-time).
+void samplv1_convolver_impl::reset (void)
+{
+	for (uint16_t k = 0; k < 2; ++k) {
+		m_head[k]->reset();
+		::memset(m_hinp[k], 0, m_hsize * sizeof(float));
+		::memset(m_hout[k], 0, m_hsize * sizeof(float));
+	}
+
+	m_hpos = 0;
+
+	// restart tail alignment; the worker clears
+	// its own state before the next tail block.
+	m_tpos = 0;
+	m_odelay = m_toffs;
+	m_opos = 0;
+	m_oblock = m_tblock;
+	m_omiss = m_oblock - 1;
+
+	m_treset.store(true, std::memory_order_release);
+}
+
+
+// process (real-time).
+void samplv1_convolver_impl::process (
+	float *in0, float *in1, uint32_t nframes, float wet )
+{
+	float *ins[2] = { in0, in1 };
+
+	uint32_t i = 0;
+	while (i < nframes) {
+		uint32_t n = m_hsize - m_hpos;
+		if (n > nframes - i)
+			n = nframes - i;
+		for (uint16_t k = 0; k < 2; ++k) {
+			float *in = ins[k] + i;
+			float *hinp = m_hinp[k] + m_hpos;
+			const float *hout = m_hout[k] + m_hpos;
+			for (uint32_t j = 0; j < n; ++j) {
+				hinp[j] = in[j];
+				in[j] += wet * hout[j];
+			}
+		}
+		m_hpos += n;
+		i += n;
+		if (m_hpos >= m_hsize) {
+			process_head();
+			m_hpos = 0;
+		}
+	}
+}
+
+
+// process one head block (real-time).
+void samplv1_convolver_impl::process_head (void)
+{
+	uint16_t k;
+
+	for (k = 0; k < 2; ++k)
+		m_head[k]->process(m_hinp[k], m_hout[k]);
+
+	if (m_thread == nullptr)
+		return;
+
+	// tail output, when due and ready...
+	if (m_odelay > 0) {
+		m_odelay -= m_hsize;
+	} else {
+		const uint32_t tdone = m_tdone.load(std::memory_order_acquire);
+		if (int32_t(tdone - m_oblock) > 0) {
+			const uint32_t offs = (m_oblock & SLOT_MASK) * m_tsize + m_opos;
+			for (k = 0; k < 2; ++k) {
+				float *hout = m_hout[k];
+				const float *tout = m_tout[k] + offs;
+				for (uint32_t j = 0; j < m_hsize; ++j)
+					hout[j] += tout[j];
+			}
+		}
+		else
+		if (m_omiss != m_oblock) {
+			// late: a hole in the tail (counted once per block).
+			m_omiss = m_oblock;
+			samplv1_sched::deadline_miss();
+		}
+		m_opos += m_hsize;
+		if (m_opos >= m_tsize) {
+			m_opos = 0;
+			++m_oblock;
+		}
+	}
+
+	// tail input, schedule when complete...
+	const uint32_t offs = (m_tblock & SLOT_MASK) * m_tsize + m_tpos;
+	for (k = 0; k < 2; ++k)
+		::memcpy(m_tinp[k] + offs, m_hinp[k], m_hsize * sizeof(float));
+	m_tpos += m_hsize;
+	if (m_tpos >= m_tsize) {
+		m_tpos = 0;
+		m_treq.store(++m_tblock, std::memory_order_release);
+		m_thread->schedule();
+	}
+}
+
+
+// process all pending tail blocks (worker).
+void samplv1_convolver_impl::process_tail (void)
+{
+	for (;;) {
+		const uint32_t treq = m_treq.load(std::memory_order_acquire);
+		if (m_tseq == treq)
+			break;
+		if (m_treset.exchange(false, std::memory_order_acq_rel)) {
+			for (uint16_t k = 0; k < 2; ++k)
+				m_tail[k]->reset();
+		}
+		const uint32_t offs = (m_tseq & SLOT_MASK) * m_tsize;
+		for (uint16_t k = 0; k < 2; ++k)
+			m_tail[k]->process(m_tinp[k] + offs, m_tout[k] + offs);
+		m_tdone.store(++m_tseq, std::memory_order_release);
+	}
+}
+
+
+#else	// !CONFIG_FFTW3
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver_impl - null impulse response (no FFTW3).
+//
+
+class samplv1_convolver_impl
+{
+public:
+
+	samplv1_convolver_impl(float = 0.0f,
+		uint32_t = 0, const samplv1_convolver_file * = nullptr) {}
+
+	bool isValid() const { return false; }
+	uint32_t tail() const { return 0; }
+	uint32_t tsize() const { return 0; }
+
+	static uint32_t tail_size(uint32_t) { return 0; }
+
+	void reset() {}
+	void process(float *, float *, uint32_t, float) {}
+};
+
+
+#endif	// !CONFIG_FFTW3
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver - impulse response (convolution) reverb.
+//
+
+// ctor.
+samplv1_convolver::samplv1_convolver ( float srate, uint32_t nsize )
+	: m_srate(srate), m_nsize(nsize), m_nperiod(0),
+		m_filename(nullptr), m_file(nullptr),
+		m_impl(nullptr), m_impl_next(nullptr), m_impl_free(nullptr),
+		m_rebuild(false), m_sync_req(false), m_reset(false), m_resized(false)
+{
+}
+
+
+// dtor.
+samplv1_convolver::~samplv1_convolver (void)
+{
+	delete m_impl_free.exchange(nullptr);
+	delete m_impl_next.exchange(nullptr);
+
+	if (m_impl)
+		delete m_impl;
+
+	if (m_file)
+		delete m_file;
+
+	if (m_filename)
+		::free(m_filename);
+}
+
+
+// properties (any thread; rebuilds on next sync_buffers).
+void samplv1_convolver::setSampleRate ( float srate )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_srate == srate)
+		return;
+
+	m_srate = srate;
+
+	if (m_file) {
+		m_rebuild = true;
+		m_sync_req.store(true, std::memory_order_release);
+	}
+}
+
+
+void samplv1_convolver::setBufferSize ( uint32_t nsize )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_nsize == nsize)
+		return;
+
+	m_nsize = nsize;
+
+	if (m_file) {
+		m_rebuild = true;
+		m_sync_req.store(true, std::memory_order_release);
+	}
+}
+
+
+// impulse response file (non-real-time).
+bool samplv1_convolver::open ( const char *filename )
+{
+	if (filename == nullptr) {
+		close();
+		return false;
+	}
+
+	samplv1_convolver_file *file = new samplv1_convolver_file(filename);
+	if (!file->isValid()) {
+		delete file;
+		close();
+		return false;
+	}
+
+	QMutexLocker locker(&m_mutex);
+
+	samplv1_convolver_impl *impl
+		= new samplv1_convolver_impl(m_srate, period(), file);
+	if (!impl->isValid()) {
+		delete impl;
+		delete file;
+		clear();
+		return false;
+	}
+
+	if (m_file)
+		delete m_file;
+	m_file = file;
+	m_rebuild = false;
+
+	char *filename2 = ::strdup(filename);
+	if (m_filename)
+		::free(m_filename);
+	m_filename = filename2;
+
+	post(impl);
+	return true;
+}
+
+
+void samplv1_convolver::close (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	clear();
+}
+
+
+// drop the current impulse response, if any (locked).
+void samplv1_convolver::clear (void)
+{
+	if (m_file) {
+		delete m_file;
+		m_file = nullptr;
+	}
+
+	m_rebuild = false;
+
+	if (m_filename) {
+		::free(m_filename);
+		m_filename = nullptr;
+	}
+
+	post(new samplv1_convolver_impl());
+}
+
+
+// post a new impulse response (or none).
+void samplv1_convolver::post ( samplv1_convolver_impl *impl )
+{
+	sync_free();
+
+	// replace any previous one never picked up...
+	delete m_impl_next.exchange(impl, std::memory_order_acq_rel);
+}
+
+
+// period the tail partitions are sized for: the largest one actually
+// processed so far, or else the nominal buffer size, as a first guess.
+uint32_t samplv1_convolver::period (void) const
+{
+	const uint32_t nperiod = m_nperiod.load(std::memory_order_acquire);
+	return (nperiod > 0 ? nperiod : m_nsize);
+}
+
+
+// free whatever the real-time thread left behind.
+void samplv1_convolver::sync_free (void)
+{
+	delete m_impl_free.exchange(nullptr, std::memory_order_acq_rel);
+}
+
+
+// rebuild and/or free impulse responses (worker thread).
+void samplv1_convolver::sync_buffers (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_rebuild.exchange(false) && m_file) {
+		samplv1_convolver_impl *impl
+			= new samplv1_convolver_impl(m_srate, period(), m_file);
+		post(impl);
+	} else {
+		sync_free();
+	}
+}
+
+
+// real-time: pick up any pending impulse response.
+bool samplv1_convolver::sync (void)
+{
+	// only when the previous one has been freed...
+	if (m_impl_free.load(std::memory_order_acquire) == nullptr) {
+		samplv1_convolver_impl *impl
+			= m_impl_next.exchange(nullptr, std::memory_order_acq_rel);
+		if (impl) {
+			if (m_impl) {
+				m_impl_free.store(m_impl, std::memory_order_release);
+				m_sync_req.store(true, std::memory_order_release);
+			}
+			m_impl = impl;
+			m_reset = false;
+			m_resized = false;
+			m_tail.reset();
+		}
+	}
+
+	return (m_impl && m_impl->isValid());
+}
+
+
+// real-time: process (stereo, in-place, additive wet).
+bool samplv1_convolver::process (
+	float *in0, float *in1, uint32_t nframes, float wet, bool silent )
+{
+	if (m_impl == nullptr || !m_impl->isValid())
+		return silent;
+
+	// tail partitions follow the actual period (largest so far),
+	// not the nominal buffer size (which may be a lot larger)...
+	uint32_t nperiod = m_nperiod.load(std::memory_order_relaxed);
+	if (nperiod < nframes) {
+		nperiod = nframes;
+		m_nperiod.store(nperiod, std::memory_order_release);
+	}
+	if (!m_resized && m_impl->tsize()
+		!= samplv1_convolver_impl::tail_size(nperiod)) {
+		m_resized = true;
+		m_rebuild.store(true, std::memory_order_release);
+		m_sync_req.store(true, std::memory_order_release);
+	}
+
+	if (m_reset) {
+		m_reset = false;
+		m_impl->reset();
+		m_tail.reset();
+	}
+
+	if (wet < 1E-9f)
+		return silent;
+
+	// tail bypass (silence propagation)
+	if (!m_tail.process(silent, nframes, m_impl->tail()))
+		return true;
+
+	m_impl->process(in0, in1, nframes, wet);
+
+	return false;
+}
+
+
+// end of samplv1_convolver.cpp
@@ -0,0 +1,152 @@
+// samplv1_convolver.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __samplv1_convolver_h
+#define __samplv1_convolver_h
+
+#include "config.h"
+
+#include "samplv1_fx.h"
+
+#include <QMutex>
+
+#include <atomic>
+
+
+// forward decls.
+class samplv1_convolver_impl;
+class samplv1_convolver_file;
+
+
+//-------------------------------------------------------------------------
+// samplv1_convolver - impulse response (convolution) reverb.
+//
+// Non-uniformly partitioned: the first (head) part of the impulse
+// response is convolved in small uniform partitions on the real-time
+// thread; the remaining (tail) part is convolved in large uniform
+// partitions by a dedicated worker thread, scheduled ahead of time,
+// running just one priority below the real-time thread. Tail blocks
+// are sized after the actual processing period, as seen in process().
+// Adds HEAD_SIZE frames of (pre-delay) latency to the wet signal.
+//
+
+class samplv1_convolver
+{
+public:
+
+	// head partition size (frames).
+	static const uint32_t HEAD_SIZE = 64;
+
+	// maximum impulse response length (seconds).
+	static const uint32_t MAX_SECS = 20;
+
+	// ctor.
+	samplv1_convolver(float srate = 44100.0f, uint32_t nsize = 1024);
+
+	// dtor.
+	~samplv1_convolver();
+
+	// properties (any thread; rebuilds on next sync_buffers).
+	void setSampleRate(float srate);
+	float sampleRate() const
+		{ return m_srate; }
+
+	// nominal buffer size: a first guess for the period, only.
+	void setBufferSize(uint32_t nsize);
+	uint32_t bufferSize() const
+		{ return m_nsize; }
+
+	// impulse response file (non-real-time).
+	bool open(const char *filename);
+	void close();
+
+	const char *filename() const
+		{ return m_filename; }
+
+	// reset state (applied on next process).
+	void reset()
+		{ m_reset = true; }
+
+	// real-time: pick up any pending impulse response;
+	// returns whether there's one currently loaded.
+	bool sync();
+
+	// real-time: process (stereo, in-place, additive wet).
+	bool process(float *in0, float *in1, uint32_t nframes,
+		float wet, bool silent = false);
+
+	// whether it needs to be synced (real-time thread).
+	bool sync_request()
+		{ return m_sync_req.exchange(false, std::memory_order_acquire); }
+
+	// rebuild and/or free impulse responses (worker thread).
+	void sync_buffers();
+
+protected:
+
+	// drop the current impulse response, if any.
+	void clear();
+
+	// post a new impulse response (or none).
+	void post(samplv1_convolver_impl *impl);
+
+	// free whatever the real-time thread left behind.
+	void sync_free();
+
+	// period the tail partitions are sized for.
+	uint32_t period() const;
+
+private:
+
+	float    m_srate;
+	uint32_t m_nsize;
+
+	// largest period processed so far (real-time).
+	std::atomic<uint32_t> m_nperiod;
+
+	char    *m_filename;
+
+	// impulse response file data, as loaded (non-real-time).
+	samplv1_convolver_file *m_file;
+
+	QMutex m_mutex;
+
+	// current (real-time), next and garbage impulse responses.
+	samplv1_convolver_impl *m_impl;
+
+	std::atomic<samplv1_convolver_impl *> m_impl_next;
+	std::atomic<samplv1_convolver_impl *> m_impl_free;
+
+	std::atomic<bool> m_rebuild;
+	std::atomic<bool> m_sync_req;
+
+	volatile bool m_reset;
+
+	// whether current one is already due for a rebuild (real-time).
+	bool m_resized;
+
+	samplv1_fx_tail m_tail;
+};
+
+
+#endif	// __samplv1_convolver_h
+
+// end of samplv1_convolver.h
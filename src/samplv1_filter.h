@@ -174,8 +174,94 @@ public:
 
 	enum Type { Low = 0, Band, High, Notch };
 
+	// shared coefficient look-up tables.
+	//
+	// all four filter types derive from the same three terms:
+	// sin(omega), cos(omega) and 1/a0 = 1/(1 + alpha); the first
+	// two depend on cutoff alone, the later on cutoff and reso.
+	class Table
+	{
+	public:
+
+		static const uint32_t NUM_CUTOFFS1 = 512;
+		static const uint32_t NUM_CUTOFFS2 = 128;
+		static const uint32_t NUM_RESOS2   = 32;
+
+		Table()
+		{
+			uint32_t i, j;
+
+			for (i = 0; i <= NUM_CUTOFFS1; ++i) {
+				const float omega = M_PI * float(i) / float(NUM_CUTOFFS1);
+				m_tsin[i] = ::sinf(omega);
+				m_tcos[i] = ::cosf(omega);
+			}
+
+			m_tsin[NUM_CUTOFFS1 + 1] = m_tsin[NUM_CUTOFFS1];
+			m_tcos[NUM_CUTOFFS1 + 1] = m_tcos[NUM_CUTOFFS1];
+
+			for (j = 0; j <= NUM_RESOS2 + 1; ++j) {
+				const float reso = float(j < NUM_RESOS2 ? j : NUM_RESOS2)
+					/ float(NUM_RESOS2);
+				const float q = 2.0f * reso * reso + 1.0f;
+				float *ia0 = m_ia0[j];
+				for (i = 0; i <= NUM_CUTOFFS2; ++i) {
+					const float omega = M_PI * float(i) / float(NUM_CUTOFFS2);
+					const float alpha = ::sinf(omega) / (2.0f * q);
+					ia0[i] = 1.0f / (1.0f + alpha);
+				}
+				ia0[NUM_CUTOFFS2 + 1] = ia0[NUM_CUTOFFS2];
+			}
+		}
+
+		// interpolated sin/cos(omega) and 1/a0 terms.
+		void lookup(float cutoff, float reso,
+			float& tsin, float& tcos, float& ia0) const
+		{
+			if (cutoff < 0.0f) cutoff = 0.0f; else if (cutoff > 1.0f) cutoff = 1.0f;
+			if (reso   < 0.0f) reso   = 0.0f; else if (reso   > 1.0f) reso   = 1.0f;
+
+			const float fi = cutoff * float(NUM_CUTOFFS1);
+			const uint32_t i = uint32_t(fi);
+			const float di = fi - float(i);
+
+			tsin = m_tsin[i] + di * (m_tsin[i + 1] - m_tsin[i]);
+			tcos = m_tcos[i] + di * (m_tcos[i + 1] - m_tcos[i]);
+
+			const float fk = cutoff * float(NUM_CUTOFFS2);
+			const uint32_t k = uint32_t(fk);
+			const float dk = fk - float(k);
+
+			const float fj = reso * float(NUM_RESOS2);
+			const uint32_t j = uint32_t(fj);
+			const float dj = fj - float(j);
+
+			const float *ia1 = m_ia0[j];
+			const float *ia2 = m_ia0[j + 1];
+			const float ia01 = ia1[k] + dk * (ia1[k + 1] - ia1[k]);
+			const float ia02 = ia2[k] + dk * (ia2[k + 1] - ia2[k]);
+
+			ia0 = ia01 + dj * (ia02 - ia01);
+		}
+
+	private:
+
+		float m_tsin[NUM_CUTOFFS1 + 2];
+		float m_tcos[NUM_CUTOFFS1 + 2];
+
+		float m_ia0[NUM_RESOS2 + 2][NUM_CUTOFFS2 + 2];
+	};
+
+	// global/shared tables accessor.
+	static const Table *table()
+	{
+		static const Table s_table;
+		return &s_table;
+	}
+
 	samplv1_filter3(Type type = Low)
-		: m_type(type), m_cutoff(0.5f), m_reso(0.0f) { reset(type); }
+		: m_type(type), m_table(table()), m_cutoff(0.5f), m_reso(0.0f)
+		{ reset(type); }
 
 	Type type() const
 		{ return m_type; }
@@ -219,50 +305,37 @@ protected:
 
 	void reset()
 	{
-		const float q = 2.0f * m_reso * m_reso + 1.0f;
+		float tsin, tcos, ia0;
 
-		const float omega = M_PI * m_cutoff;
-		const float tsin  = ::sinf(omega);
-		const float tcos  = ::cosf(omega);
-		const float alpha = tsin / (2.0f * q);
-
-		// temp vars
-		const float a0 =  1.0f + alpha;
-		const float a1 = -2.0f * tcos;
-		const float a2 =  1.0f - alpha;
-
-		float b0, b1, b2;
+		m_table->lookup(m_cutoff, m_reso, tsin, tcos, ia0);
 
+		// set filter coeffs
 		switch (m_type) {
 		case Notch:
-			b0 =  1.0f;
-			b1 = -2.0f * tcos;
-			b2 =  1.0f;
+			m_b0a0 =  ia0;
+			m_b1a0 = -2.0f * tcos * ia0;
+			m_b2a0 =  ia0;
 			break;
 		case High:
-			b0 = (1.0f + tcos) / 2.0f;
-			b1 = -1.0f - tcos;
-			b2 =  b0;
+			m_b0a0 =  0.5f * (1.0f + tcos) * ia0;
+			m_b1a0 = -2.0f * m_b0a0;
+			m_b2a0 =  m_b0a0;
 			break;
 		case Band:
-			b0 =  tsin / 2.0f;
-			b1 =  0.0f;
-			b2 = -b0;
+			m_b0a0 =  0.5f * tsin * ia0;
+			m_b1a0 =  0.0f;
+			m_b2a0 = -m_b0a0;
 			break;
 		case Low:
 		default:
-			b0 = (1.0f - tcos) / 2.0f;
-			b1 =  1.0f - tcos;
-			b2 =  b0;
+			m_b0a0 =  0.5f * (1.0f - tcos) * ia0;
+			m_b1a0 =  2.0f * m_b0a0;
+			m_b2a0 =  m_b0a0;
 			break;
 		}
 
-		// set filter coeffs
-		m_b0a0 = b0 / a0;
-		m_b1a0 = b1 / a0;
-		m_b2a0 = b2 / a0;
-		m_a1a0 = a1 / a0;
-		m_a2a0 = a2 / a0;
+		m_a1a0 = -2.0f * tcos * ia0;
+		m_a2a0 =  2.0f * ia0 - 1.0f; // (1 - alpha) / (1 + alpha)
 	}
 
 private:
@@ -270,6 +343,9 @@ private:
 	// filter type 
 	Type  m_type;
 
+	// shared coeffs. tables
+	const Table *m_table;
+
 	// filter params
 	float m_cutoff;
 	float m_reso;
@@ -282,6 +358,150 @@ private:
 };
 
 
+//-------------------------------------------------------------------------
+// samplv1_halfband - polyphase IIR halfband (2x up/down-sampler).
+//
+//   two parallel chains of first-order allpass sections, after
+//   Olli Niemitalo's and Laurent de Soras' "hiir" structure.
+
+template <uint16_t NCOEFS>
+class samplv1_halfband
+{
+public:
+
+	samplv1_halfband(const float *coefs) : m_coefs(coefs)
+		{ reset(); }
+
+	void reset()
+	{
+		for (uint16_t i = 0; i < NCOEFS; ++i)
+			m_x[i] = m_y[i] = 0.0f;
+	}
+
+	// one input frame into two.
+	void upsample(float in, float *out)
+	{
+		float spl0 = in;
+		float spl1 = in;
+		process(spl0, spl1);
+		out[0] = spl0;
+		out[1] = spl1;
+	}
+
+	// two input frames into one.
+	float downsample(const float *in)
+	{
+		float spl0 = in[1];
+		float spl1 = in[0];
+		process(spl0, spl1);
+		return 0.5f * (spl0 + spl1);
+	}
+
+protected:
+
+	void process(float& spl0, float& spl1)
+	{
+		for (uint16_t i = 0; i < NCOEFS; i += 2) {
+			spl0 = allpass(i, spl0);
+			spl1 = allpass(i + 1, spl1);
+		}
+	}
+
+	float allpass(uint16_t i, float in)
+	{
+		const float out = (in - m_y[i]) * m_coefs[i] + m_x[i];
+		m_x[i] = in;
+		m_y[i] = out;
+		return out;
+	}
+
+private:
+
+	const float *m_coefs;
+
+	float m_x[NCOEFS];
+	float m_y[NCOEFS];
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_oversampler - 2x/4x cascaded halfband up/down-sampler.
+//
+//   first stage: steep (~100dB stopband above 0.46 of base rate);
+//   second stage: relaxed, as there's no content in between.
+
+class samplv1_oversampler
+{
+public:
+
+	enum Ratio { Over1x = 0, Over2x, Over4x };
+
+	samplv1_oversampler()
+		: m_up1(coefs1()), m_up2(coefs2()),
+			m_dn1(coefs1()), m_dn2(coefs2()) {}
+
+	void reset()
+	{
+		m_up1.reset();
+		m_up2.reset();
+		m_dn1.reset();
+		m_dn2.reset();
+	}
+
+	// one frame into 2 (or 4).
+	void upsample2(float in, float *out)
+		{ m_up1.upsample(in, out); }
+
+	void upsample4(float in, float *out)
+	{
+		float tmp[2];
+		m_up1.upsample(in, tmp);
+		m_up2.upsample(tmp[0], out);
+		m_up2.upsample(tmp[1], out + 2);
+	}
+
+	// 2 (or 4) frames into one.
+	float downsample2(const float *in)
+		{ return m_dn1.downsample(in); }
+
+	float downsample4(const float *in)
+	{
+		float tmp[2];
+		tmp[0] = m_dn2.downsample(in);
+		tmp[1] = m_dn2.downsample(in + 2);
+		return m_dn1.downsample(tmp);
+	}
+
+protected:
+
+	static const float *coefs1()
+	{
+		// 8 coefs., 0.04 transition band.
+		static const float s_coefs1[8] = {
+			0.0406334609f, 0.1505051290f, 0.3007570560f, 0.4607745050f,
+			0.6095243149f, 0.7385038411f, 0.8492238104f, 0.9497427837f
+		};
+		return s_coefs1;
+	}
+
+	static const float *coefs2()
+	{
+		// 4 coefs., 0.2 transition band.
+		static const float s_coefs2[4] = {
+			0.0495510353f, 0.1935703263f, 0.4267366888f, 0.7670700728f
+		};
+		return s_coefs2;
+	}
+
+private:
+
+	samplv1_halfband<8> m_up1;
+	samplv1_halfband<4> m_up2;
+	samplv1_halfband<8> m_dn1;
+	samplv1_halfband<4> m_dn2;
+};
+
+
 #endif	// __samplv1_filter_h
 
 
@@ -218,8 +218,14 @@ void samplv1_formant::reset_coeffs (void)
 {
 	if (m_pImpl) {
 		m_pImpl->reset_coeffs(m_cutoff, m_reso);
-		for (uint32_t i = 0; i < NUM_FORMANTS; ++i)
-			m_filters[i].reset_coeffs(m_pImpl->coeffs(i));
+		const float fstep = 1.0f / float(NUM_STEPS);
+		for (uint32_t i = 0; i < NUM_FORMANTS; ++i) {
+			const Coeffs& coeffs = m_pImpl->coeffs(i);
+			m_va0[i] = (coeffs.a0 - m_a0[i]) * fstep;
+			m_vb1[i] = (coeffs.b1 - m_b1[i]) * fstep;
+			m_vb2[i] = (coeffs.b2 - m_b2[i]) * fstep;
+		}
+		m_cstep = NUM_STEPS;
 	}
 }
 
@@ -92,7 +92,7 @@ public:
 	// ctor.
 	samplv1_formant(Impl *pImpl = 0)
 		: m_pImpl(pImpl), m_cutoff(0.5f), m_reso(0.0f), m_nstep(0)
-		{ reset_coeffs(); }
+		{ reset_lanes(); reset_coeffs(); }
 
 	// reset impl.
 	void reset(Impl *pImpl)
@@ -100,8 +100,7 @@ public:
 
 	void reset_filters(float cutoff, float reso)
 	{
-		for (uint32_t i = 0; i < NUM_FORMANTS; ++i)
-			m_filters[i].reset();
+		reset_lanes();
 
 		update(cutoff, reso);
 	}
@@ -111,102 +110,113 @@ public:
 	{
 		update(cutoff, reso);
 
-		float out = 0.0f;
-		for (uint32_t i = 0; i < NUM_FORMANTS; ++i)
-			out += m_filters[i].output(in);
-		return out;
-	}
+		if (m_cstep > 0)
+			tick_coeffs();
 
-	// process block
-	void process(float *in, uint32_t nframes, float wet, float cutoff, float reso)
-	{
-		for (uint32_t i = 0; i < nframes; ++i) {
-			const float out = output(in[i], cutoff, reso);
-			in[i] *= (1.0f - wet);
-			in[i] += (wet * out);
-		}
+		return tick_lanes(in);
 	}
 
-protected:
-
-	// step-wise smoothed coeff.
-	class Coeff
+	// process block (mono, in-place allowed)
+	void process(float *out, const float *in, uint32_t nframes,
+		float cutoff, float reso)
 	{
-	public:
+		uint32_t i = 0;
 
-		Coeff() { reset(); }
-
-		void reset()
-		{
-			m_value = m_vstep = 0.0f;
-			m_nstep = 0;
-		}
-
-		void set_value(float value)
-		{
-			m_nstep = NUM_STEPS;
-			m_vstep = (value - m_value) / float(m_nstep);
+		while (i < nframes) {
+			// slew-rate control: params are only sampled
+			// at step boundaries, just like output() does.
+			uint32_t nread = nframes - i;
+			if (m_nstep > 0) {
+				if (nread > m_nstep)
+					nread = m_nstep;
+				m_nstep -= nread;
+			} else {
+				update(cutoff, reso);
+				if (m_nstep > 0)
+					nread = 1;
+			}
+			// coeffs. ramping span...
+			uint32_t nramp = nread;
+			if (nramp > m_cstep)
+				nramp = m_cstep;
+			uint32_t j = 0;
+			for ( ; j < nramp; ++j, ++i) {
+				tick_coeffs();
+				out[i] = tick_lanes(in[i]);
+			}
+			// steady coeffs. span...
+			for ( ; j < nread; ++j, ++i)
+				out[i] = tick_lanes(in[i]);
 		}
+	}
 
-		float value() const
-			{ return m_value + m_vstep * float(m_nstep); }
-
-		float tick()
-		{
-			if (m_nstep > 0) {
-				m_value += m_vstep;
-				--m_nstep;
+	// process block (wet/dry mix, in-place)
+	void process(float *in, uint32_t nframes, float wet, float cutoff, float reso)
+	{
+		float out[BLOCK_SIZE];
+
+		while (nframes > 0) {
+			uint32_t nread = nframes;
+			if (nread > BLOCK_SIZE)
+				nread = BLOCK_SIZE;
+			process(out, in, nread, cutoff, reso);
+			for (uint32_t i = 0; i < nread; ++i) {
+				in[i] *= (1.0f - wet);
+				in[i] += (wet * out[i]);
 			}
-			return m_value;
+			in += nread;
+			nframes -= nread;
 		}
+	}
 
-	private:
+protected:
 
-		float    m_value;
-		float    m_vstep;
-		uint32_t m_nstep;
-	};
+	// resonator lanes, padded to a multiple of the SIMD width;
+	// spare lanes are kept zero and contribute nothing.
+	static const uint32_t NUM_LANES = 8;
+	static const uint32_t BLOCK_SIZE = 64;
 
-	// 2-pole resonator filter
-	class Filter
+	// reset all lanes state (coeffs. and history).
+	void reset_lanes()
 	{
-	public:
-
-		Filter() { reset(); }
+		for (uint32_t k = 0; k < NUM_LANES; ++k) {
+			m_a0[k] = m_b1[k] = m_b2[k] = 0.0f;
+			m_va0[k] = m_vb1[k] = m_vb2[k] = 0.0f;
+			m_out1[k] = m_out2[k] = 0.0f;
+		}
 
-		void reset()
-		{
-			m_a0.reset();
-			m_b1.reset();
-			m_b2.reset();
+		m_cstep = 0;
+	}
 
-			m_out1 = m_out2 = 0.0f;
+	// step-wise smoothed coeffs., all lanes at once.
+	void tick_coeffs()
+	{
+		for (uint32_t k = 0; k < NUM_LANES; ++k) {
+			m_a0[k] += m_va0[k];
+			m_b1[k] += m_vb1[k];
+			m_b2[k] += m_vb2[k];
 		}
 
-		void reset_coeffs(const Coeffs& coeffs)
-		{
-			m_a0.set_value(coeffs.a0);
-			m_b1.set_value(coeffs.b1);
-			m_b2.set_value(coeffs.b2);
-		}
+		--m_cstep;
+	}
 
-		float output(float in)
-		{
-			const float out
-				= m_a0.tick() * in
-				+ m_b1.tick() * m_out1
-				- m_b2.tick() * m_out2;
+	// 2-pole resonators, all lanes at once.
+	float tick_lanes(float in)
+	{
+		float out = 0.0f;
 
-			m_out2 = m_out1;
-			m_out1 = out;
-			return out;
+		for (uint32_t k = 0; k < NUM_LANES; ++k) {
+			const float out0
+				= m_a0[k] * in
+				+ m_b1[k] * m_out1[k]
+				- m_b2[k] * m_out2[k];
+			m_out2[k] = m_out1[k];
+			m_out1[k] = out0;
+			out += out0;
 		}
 
-	private:
-
-		Coeff m_a0, m_b1, m_b2;
-		float m_out1, m_out2;
-	};
+		return out;
+	}
 
 	// update method
 	void update(float cutoff, float reso)
@@ -238,8 +248,19 @@ private:
 	// slew-rate control.
 	uint32_t m_nstep;
 
-	// formant filters
-	Filter m_filters[NUM_FORMANTS];
+	// formant filters (SoA lanes)
+	alignas(32) float m_a0[NUM_LANES];
+	alignas(32) float m_b1[NUM_LANES];
+	alignas(32) float m_b2[NUM_LANES];
+
+	alignas(32) float m_va0[NUM_LANES];
+	alignas(32) float m_vb1[NUM_LANES];
+	alignas(32) float m_vb2[NUM_LANES];
+
+	alignas(32) float m_out1[NUM_LANES];
+	alignas(32) float m_out2[NUM_LANES];
+
+	uint32_t m_cstep;
 
 	// base vocal tables
 	static Vtab  g_bass_vtab[NUM_VOWELS];
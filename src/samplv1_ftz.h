@@ -0,0 +1,90 @@
+// samplv1_ftz.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __samplv1_ftz_h
+#define __samplv1_ftz_h
+
+#include <cstdint>
+
+#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+#include <xmmintrin.h>
+#endif
+
+
+//-------------------------------------------------------------------------
+// samplv1_ftz - flush-to-zero/denormals-are-zero (scoped) mode
+
+class samplv1_ftz
+{
+public:
+
+	samplv1_ftz(bool enabled) : m_enabled(enabled), m_state(0)
+	{
+		if (m_enabled) {
+		#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+			m_state = _mm_getcsr();
+			_mm_setcsr(m_state | 0x8040); // FTZ | DAZ
+		#elif defined(__aarch64__)
+			uint64_t fpcr;
+			__asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+			m_state = fpcr;
+			fpcr |= (uint64_t(1) << 24); // FZ
+			__asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+		#endif
+		}
+	}
+
+	~samplv1_ftz()
+	{
+		if (m_enabled) {
+		#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+			_mm_setcsr(uint32_t(m_state));
+		#elif defined(__aarch64__)
+			const uint64_t fpcr = m_state;
+			__asm__ __volatile__ ("msr fpcr, %0" : : "r" (fpcr));
+		#endif
+		}
+	}
+
+	// whether denormals are flushed on the calling thread, now.
+	static bool isActive()
+	{
+	#if defined(__SSE__) || defined(__x86_64__) || defined(_M_X64)
+		return (_mm_getcsr() & 0x8000); // FTZ
+	#elif defined(__aarch64__)
+		uint64_t fpcr;
+		__asm__ __volatile__ ("mrs %0, fpcr" : "=r" (fpcr));
+		return (fpcr & (uint64_t(1) << 24)); // FZ
+	#else
+		return false;
+	#endif
+	}
+
+private:
+
+	bool     m_enabled;
+	uint64_t m_state;
+};
+
+
+#endif	// __samplv1_ftz_h
+
+// end of samplv1_ftz.h
@@ -24,8 +24,14 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <cstring>
 #include <cmath>
 
+#include <algorithm>
+#include <atomic>
+
+#include "samplv1_ftz.h"
+
 
 //-------------------------------------------------------------------------
 // samplv1_fx
@@ -42,6 +48,170 @@ static inline float samplv1_fx_randf ()
 	return s_srand / float(INT32_MAX) - 1.0f;
 }
 
+// anti-denormal noise, unless denormals are flushed already.
+static inline float samplv1_fx_adenormal ()
+{
+	return (samplv1_ftz::isActive() ? 0.0f : 1E-14f * samplv1_fx_randf());
+}
+
+//-------------------------------------------------------------------------
+// samplv1_fx_sincos - Shared sine/cosine look-up table.
+
+class samplv1_fx_sincos
+{
+public:
+
+	static const uint32_t TABLE_SIZE = (1 << 12);	//= 4096;
+	static const uint32_t TABLE_MASK = TABLE_SIZE - 1;
+
+	samplv1_fx_sincos()
+	{
+		for (uint32_t i = 0; i <= TABLE_SIZE; ++i)
+			m_table[i] = ::sinf(2.0f * M_PI * float(i) / float(TABLE_SIZE));
+	}
+
+	// interpolated sin/cos(phase); phase in radians, any sign.
+	void lookup(float phase, float& s, float& c) const
+	{
+		float x = phase * float(TABLE_SIZE) / (2.0f * M_PI);
+		x -= float(TABLE_SIZE) * ::floorf(x / float(TABLE_SIZE));
+		const uint32_t i = uint32_t(x) & TABLE_MASK;
+		const float dx = x - ::floorf(x);
+		const uint32_t j = (i + (TABLE_SIZE >> 2)) & TABLE_MASK;
+		s = m_table[i] + dx * (m_table[i + 1] - m_table[i]);
+		c = m_table[j] + dx * (m_table[j + 1] - m_table[j]);
+	}
+
+	// global/shared table accessor.
+	static const samplv1_fx_sincos *table()
+	{
+		static const samplv1_fx_sincos s_table;
+		return &s_table;
+	}
+
+private:
+
+	float m_table[TABLE_SIZE + 1];
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_fx_quad - Quadrature (rotating phasor) sine oscillator.
+//
+// re-synced from the shared table on every block, so that
+// the recurrence never drifts; no trig calls per frame.
+
+class samplv1_fx_quad
+{
+public:
+
+	samplv1_fx_quad() : m_table(samplv1_fx_sincos::table())
+		{ reset(); }
+
+	void reset(float phase = 0.0f)
+	{
+		m_phase = phase;
+		m_delta = 0.0f;
+
+		m_table->lookup(m_phase, m_sin, m_cos);
+
+		m_dsin = 0.0f;
+		m_dcos = 1.0f;
+	}
+
+	// start block with given phase increment (radians/frame).
+	void start(float delta)
+	{
+		m_delta = delta;
+
+		m_table->lookup(m_phase, m_sin, m_cos);
+		m_table->lookup(m_delta, m_dsin, m_dcos);
+	}
+
+	// next sine value (and rotate phasor).
+	float tick()
+	{
+		const float s = m_sin;
+		m_sin = s * m_dcos + m_cos * m_dsin;
+		m_cos = m_cos * m_dcos - s * m_dsin;
+		return s;
+	}
+
+	// end block: advance reference phase (wrapped).
+	void finish(uint32_t nframes)
+	{
+		m_phase += float(nframes) * m_delta;
+		if (m_phase >= 2.0f * M_PI || m_phase < 0.0f)
+			m_phase -= 2.0f * M_PI * ::floorf(m_phase / (2.0f * M_PI));
+	}
+
+	float phase() const
+		{ return m_phase; }
+
+private:
+
+	const samplv1_fx_sincos *m_table;
+
+	float m_phase;
+	float m_delta;
+
+	float m_sin, m_cos;
+	float m_dsin, m_dcos;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_fx_tail - Effect tail tracker (silence propagation).
+
+class samplv1_fx_tail
+{
+public:
+
+	samplv1_fx_tail() : m_frames(0) {}
+
+	void reset()
+		{ m_frames = 0; }
+
+	// tail length estimate of a delay loop with feedback (-100dB).
+	static uint32_t frames(float ndelay, float feedb)
+	{
+		feedb = ::fabsf(feedb);
+		if (feedb > 0.9999f)
+			return MAX_FRAMES;
+		float nrepeats = 0.0f;
+		if (feedb > 1E-5f)
+			nrepeats = ::logf(1E-5f) / ::logf(feedb);
+		const float nframes = ndelay * (1.0f + nrepeats);
+		if (nframes < float(MAX_FRAMES))
+			return uint32_t(nframes) + 1;
+		else
+			return MAX_FRAMES;
+	}
+
+	// whether to process: false when both the input
+	// and the remaining tail are silent (bypass).
+	bool process(bool silent, uint32_t nframes, uint32_t ntail)
+	{
+		if (!silent) {
+			m_frames = ntail;
+			return true;
+		}
+		if (m_frames >= MAX_FRAMES)
+			return true;
+		if (m_frames > 0) {
+			m_frames = (m_frames > nframes ? m_frames - nframes : 0);
+			return true;
+		}
+		return false;
+	}
+
+	static const uint32_t MAX_FRAMES = 0x7fffffff;
+
+private:
+
+	uint32_t m_frames;
+};
+
 
 //-------------------------------------------------------------------------
 // samplv1_fx_filter - RBJ biquad filter implementation.
@@ -202,6 +372,39 @@ public:
 		return out;
 	}
 
+	// process a cascade of three, in-place and block-wise:
+	// all state kept in registers, the three independent
+	// recursions interleaved in the same loop.
+	static void process3(samplv1_fx_filter& f1, samplv1_fx_filter& f2,
+		samplv1_fx_filter& f3, float *inout, uint32_t nframes)
+	{
+		const float b01 = f1.m_b0a0, b11 = f1.m_b1a0, b21 = f1.m_b2a0;
+		const float a11 = f1.m_a1a0, a21 = f1.m_a2a0;
+		const float b02 = f2.m_b0a0, b12 = f2.m_b1a0, b22 = f2.m_b2a0;
+		const float a12 = f2.m_a1a0, a22 = f2.m_a2a0;
+		const float b03 = f3.m_b0a0, b13 = f3.m_b1a0, b23 = f3.m_b2a0;
+		const float a13 = f3.m_a1a0, a23 = f3.m_a2a0;
+
+		float x11 = f1.m_in1, x21 = f1.m_in2, y11 = f1.m_out1, y21 = f1.m_out2;
+		float x12 = f2.m_in1, x22 = f2.m_in2, y12 = f2.m_out1, y22 = f2.m_out2;
+		float x13 = f3.m_in1, x23 = f3.m_in2, y13 = f3.m_out1, y23 = f3.m_out2;
+
+		for (uint32_t i = 0; i < nframes; ++i) {
+			const float x0 = inout[i];
+			const float y01 = b01 * x0 + b11 * x11 + b21 * x21 - a11 * y11 - a21 * y21;
+			x21 = x11; x11 = x0; y21 = y11; y11 = y01;
+			const float y02 = b02 * y01 + b12 * x12 + b22 * x22 - a12 * y12 - a22 * y22;
+			x22 = x12; x12 = y01; y22 = y12; y12 = y02;
+			const float y03 = b03 * y02 + b13 * x13 + b23 * x23 - a13 * y13 - a23 * y23;
+			x23 = x13; x13 = y02; y23 = y13; y13 = y03;
+			inout[i] = y03;
+		}
+
+		f1.m_in1 = x11; f1.m_in2 = x21; f1.m_out1 = y11; f1.m_out2 = y21;
+		f2.m_in1 = x12; f2.m_in2 = x22; f2.m_out1 = y12; f2.m_out2 = y22;
+		f3.m_in1 = x13; f3.m_in2 = x23; f3.m_out1 = y13; f3.m_out2 = y23;
+	}
+
 protected:
 
 	void reset()
@@ -252,6 +455,8 @@ public:
 	{
 		m_peak = 0.0f;
 
+		m_tail.reset();
+
 		m_attack  = ::expf(-1000.0f / (m_srate * 3.6f));
 		m_release = ::expf(-1000.0f / (m_srate * 150.0f));
 
@@ -261,40 +466,57 @@ public:
 		m_hi.reset(samplv1_fx_filter::HiShelf, 10000.0f, 1.0f, 4.0f);
 	}
 
-	void process(float *in, uint32_t nframes)
+	bool process(float *in, uint32_t nframes, bool silent = false)
 	{
+		// eq. ringing tail (~100 msec)
+		if (!m_tail.process(silent, nframes, uint32_t(0.1f * m_srate)))
+			return true;
+		// anti-denormal noise
+		const float ad = samplv1_fx_adenormal();
+		if (ad != 0.0f) {
+			for (uint32_t i = 0; i < nframes; ++i)
+				in[i] += ad;
+		}
+		// eq. cascade
+		samplv1_fx_filter::process3(m_hi, m_mi, m_lo, in, nframes);
 		// compressor
 		const float threshold = 0.251f;	//~= powf(10.0f, -12.0f / 20.0f);
 		const float post_gain = 1.995f;	//~= powf(10.0f, 6.0f / 20.0f);
-		// process buffers
-		for (uint32_t i = 0; i < nframes; ++i) {
-			// anti-denormalizer noise
-			const float ad = 1E-14f * samplv1_fx_randf();
-			// process
-			const float lo = m_lo.output(m_mi.output(m_hi.output(*in + ad)));
-			// compute peak
-			const float peak = ::fabsf(lo);
-			// compute gain
-			float gain = 1.0f;
-			if (peak > threshold)
-				gain = threshold / peak;
+		// process buffers, block-wise
+		float gains[BLOCK_SIZE];
+		while (nframes > 0) {
+			const uint32_t nblock
+				= (nframes < BLOCK_SIZE ? nframes : BLOCK_SIZE);
+			uint32_t i;
+			// gain computer (branch-free)
+			for (i = 0; i < nblock; ++i)
+				gains[i] = threshold / std::max(::fabsf(in[i]), threshold);
 			// envelope
-			if (m_peak > gain) {
-				m_peak *= m_attack;
-				m_peak += (1.0f - m_attack) * gain;
-			} else {
-				m_peak *= m_release;
-				m_peak += (1.0f - m_release) * gain;
+			float peak = m_peak;
+			for (i = 0; i < nblock; ++i) {
+				const float gain = gains[i];
+				const float coef = (peak > gain ? m_attack : m_release);
+				peak = peak * coef + (1.0f - coef) * gain;
+				gains[i] = peak * post_gain;
 			}
+			m_peak = peak;
 			// output
-			*in++ = lo * m_peak * post_gain;
+			for (i = 0; i < nblock; ++i)
+				in[i] *= gains[i];
+			in += nblock;
+			nframes -= nblock;
 		}
+		return false;
 	}
 
 private:
 
+	static const uint32_t BLOCK_SIZE = 64;
+
 	float m_srate;
 
+	samplv1_fx_tail m_tail;
+
 	float m_peak;
 	float m_attack;
 	float m_release;
@@ -303,6 +525,141 @@ private:
 };
 
 
+//-------------------------------------------------------------------------
+// samplv1_fx_limiter - Lookahead true-peak limiter.
+//
+// Gain target from sample and half-sample (inter-sample) peaks,
+// held over the lookahead window, released smoothly and averaged
+// over the window again, so the gain reaches each peak's target
+// before it gets out. Adds LATENCY frames (~0.75 msec) of delay,
+// so it must be applied to the final output, never to a parallel
+// (eg. wet only) path, and keep running while its delay line drains.
+
+class samplv1_fx_limiter
+{
+public:
+
+	samplv1_fx_limiter(float srate = 44100.0f)
+		: m_srate(srate) { reset(); }
+
+	void setSampleRate(float srate)
+		{ m_srate = srate; }
+	float sampleRate() const
+		{ return m_srate; }
+
+	void reset()
+	{
+		uint32_t i;
+		for (i = 0; i < DELAY + BLOCK_SIZE; ++i)
+			m_x[i] = 0.0f;
+		for (i = 0; i < HOLD - 1 + BLOCK_SIZE; ++i)
+			m_g[i] = 1.0f;
+		for (i = 0; i < WINDOW - 1 + BLOCK_SIZE; ++i)
+			m_r[i] = 1.0f;
+
+		m_env = 1.0f;
+
+		m_release = ::expf(-1000.0f / (m_srate * 50.0f));
+	}
+
+	void process(float *inout, uint32_t nframes)
+	{
+		while (nframes > 0) {
+			const uint32_t nblock
+				= (nframes < BLOCK_SIZE ? nframes : BLOCK_SIZE);
+			process_block(inout, nblock);
+			inout += nblock;
+			nframes -= nblock;
+		}
+	}
+
+	// moving average window and lookahead latency (frames).
+	static const uint32_t WINDOW  = 32;
+	static const uint32_t LATENCY = WINDOW + 1;
+
+protected:
+
+	void process_block(float *inout, uint32_t nframes)
+	{
+		const float ceiling = 0.966f;	//~= powf(10.0f, -0.3f / 20.0f);
+
+		uint32_t i;
+
+		// input, delayed
+		float *x = m_x + DELAY;
+		for (i = 0; i < nframes; ++i)
+			x[i] = inout[i];
+
+		// gain targets: sample peak and cubic half-sample peak
+		// (between the previous two, still inside the hold window)
+		float *g = m_g + HOLD - 1;
+		for (i = 0; i < nframes; ++i) {
+			const float *xi = x + i;
+			const float mid = 0.5625f * (xi[-2] + xi[-1])
+				- 0.0625f * (xi[-3] + xi[0]);
+			const float peak = std::max(::fabsf(xi[0]), ::fabsf(mid));
+			g[i] = ceiling / std::max(peak, ceiling);
+		}
+
+		// hold: moving minimum over HOLD frames, in log-steps
+		float h[HOLD - 1 + BLOCK_SIZE];
+		const uint32_t nhold = HOLD - 1 + nframes;
+		for (i = 0; i < nhold; ++i)
+			h[i] = m_g[i];
+		for (uint32_t step = 1; step < WINDOW; step <<= 1) {
+			const uint32_t n = nhold - step;
+			for (i = 0; i < n; ++i)
+				h[i] = std::min(h[i], h[i + step]);
+		}
+		for (i = 0; i < nframes; ++i)
+			h[i] = std::min(h[i], h[i + HOLD - WINDOW]);
+
+		// release: instant down, smoothly up
+		float *r = m_r + WINDOW - 1;
+		float env = m_env;
+		for (i = 0; i < nframes; ++i) {
+			env = std::min(h[i], h[i] + m_release * (env - h[i]));
+			r[i] = env;
+		}
+		m_env = env;
+
+		// moving average over WINDOW frames; output
+		const float scale = 1.0f / float(WINDOW);
+		float sum = 0.0f;
+		for (i = 0; i < WINDOW - 1; ++i)
+			sum += m_r[i];
+		for (i = 0; i < nframes; ++i) {
+			sum += r[i];
+			inout[i] = m_x[i] * sum * scale;
+			sum -= m_r[i];
+		}
+
+		// shift history
+		for (i = 0; i < DELAY; ++i)
+			m_x[i] = m_x[i + nframes];
+		for (i = 0; i < HOLD - 1; ++i)
+			m_g[i] = m_g[i + nframes];
+		for (i = 0; i < WINDOW - 1; ++i)
+			m_r[i] = m_r[i + nframes];
+	}
+
+private:
+
+	static const uint32_t BLOCK_SIZE = 64;
+	static const uint32_t HOLD  = WINDOW + 2;
+	static const uint32_t DELAY = LATENCY;
+
+	float m_srate;
+
+	float m_x[DELAY + BLOCK_SIZE];
+	float m_g[HOLD - 1 + BLOCK_SIZE];
+	float m_r[WINDOW - 1 + BLOCK_SIZE];
+
+	float m_env;
+	float m_release;
+};
+
+
 //-------------------------------------------------------------------------
 // samplv1_fx_flanger - Flanger implementation.
 
@@ -320,6 +677,8 @@ public:
 			m_buffer[i] = 0.0f;
 
 		m_frames = 0;
+
+		m_tail.reset();
 	}
 
 	float output(float in, float delay, float feedb)
@@ -351,20 +710,25 @@ public:
 		return out;
 	}
 
-	void process(float *in, uint32_t nframes,
-		float wet, float delay, float feedb, float daft)
+	bool process(float *in, uint32_t nframes,
+		float wet, float delay, float feedb, float daft, bool silent = false)
 	{
 		if (wet < 1E-9f)
-			return;
+			return silent;
 		// daft effect
 		if (daft > 0.001f) {
 			delay *= (1.0f - daft);
 		//	feedb *= (1.0f - daft);
 		}
 		delay *= float(MAX_SIZE);
+		// tail bypass
+		if (!m_tail.process(silent, nframes,
+				samplv1_fx_tail::frames(delay + 4.0f, feedb)))
+			return true;
 		// process
 		for (uint32_t i = 0; i < nframes; ++i)
 			in[i] += wet * output(in[i], delay, feedb);
+		return false;
 	}
 
 	static const uint32_t MAX_SIZE = (1 << 12);	//= 4096;
@@ -375,6 +739,8 @@ private:
 	float m_buffer[MAX_SIZE];
 
 	uint32_t m_frames;
+
+	samplv1_fx_tail m_tail;
 };
 
 
@@ -399,19 +765,26 @@ public:
 		m_flang2.reset();
 
 		m_lfo = 0.0f;
+
+		m_tail.reset();
 	}
 
-	void process(float *in1, float *in2, uint32_t nframes,
-		float wet, float delay, float feedb, float rate, float mod)
+	bool process(float *in1, float *in2, uint32_t nframes,
+		float wet, float delay, float feedb, float rate, float mod,
+		bool silent = false)
 	{
 		if (wet < 1E-9f)
-			return;
+			return silent;
 		// constrained feedback
 		feedb *= 0.95f;
 		// calculate delay time
 		const float d0 = 0.5f * delay * float(samplv1_fx_flanger::MAX_SIZE);
 		const float a1 = 0.99f * d0 * mod * mod;
 		const float r2 = 4.0f * M_PI * rate * rate / m_srate;
+		// tail bypass
+		if (!m_tail.process(silent, nframes,
+				samplv1_fx_tail::frames(d0 + a1 + 4.0f, feedb)))
+			return true;
 		// process
 		for (uint32_t i = 0; i < nframes; ++i) {
 			// modulation
@@ -427,6 +800,7 @@ public:
 			if (m_lfo >= 1.0f)
 				m_lfo -= 2.0f;
 		}
+		return false;
 	}
 
 protected:
@@ -446,18 +820,36 @@ private:
 	samplv1_fx_flanger m_flang2;
 
 	float m_lfo;
+
+	samplv1_fx_tail m_tail;
 };
 
 
 //-------------------------------------------------------------------------
 // samplv1_fx_delay - Delay implementation.
+//
+// delay line memory is (re)allocated and released off the real-time
+// thread (see sync_buffers), as required by the current delay time;
+// on growth, the previous buffer keeps feeding the delay taps until
+// the new one has caught up with its contents.
 
 class samplv1_fx_delay
 {
 public:
 
 	samplv1_fx_delay(float srate = 44100.0f)
-		: m_srate(srate) { reset(); }
+		: m_srate(srate), m_buffer(nullptr),
+			m_buffer_next(nullptr), m_buffer_free(nullptr),
+			m_buffer_prev(nullptr), m_nsize_req(0), m_sync_req(false)
+			{ reset(); }
+
+	~samplv1_fx_delay()
+	{
+		delete m_buffer_free.load();
+		delete m_buffer_next.load();
+		delete m_buffer_prev;
+		delete m_buffer.load();
+	}
 
 	void setSampleRate(float srate)
 		{ m_srate = srate; }
@@ -466,18 +858,51 @@ public:
 
 	void reset()
 	{
-		for (uint32_t i = 0; i < MAX_SIZE; ++i)
-			m_buffer[i] = 0.0f;
+		Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+		if (buffer)
+			buffer->reset();
+		if (m_buffer_prev)
+			m_buffer_prev->reset();
 
 		m_out = 0.0f;
 		m_frames = 0;
+		m_frames_swap = 0;
+
+		m_tail.reset();
 	}
 
-	void process(float *in, uint32_t nframes,
-		float wet, float delay, float feedb, float bpm = 0.0f)
+	bool process(float *in, uint32_t nframes,
+		float wet, float delay, float feedb, float bpm = 0.0f,
+		bool silent = false)
 	{
-		if (wet < 1E-9f)
-			return;
+		// release the previous buffer, once caught up
+		if (m_buffer_prev
+			&& m_frames - m_frames_swap >= m_buffer_prev->nsize
+			&& release_buffer(m_buffer_prev))
+			m_buffer_prev = nullptr;
+		// pick up any newly allocated buffer
+		Buffer *buffer = m_buffer.load(std::memory_order_relaxed);
+		Buffer *buffer_next = m_buffer_next.load(std::memory_order_acquire);
+		if (buffer_next && m_buffer_prev == nullptr) {
+			m_buffer_next.store(nullptr, std::memory_order_relaxed);
+			m_buffer.store(buffer_next, std::memory_order_release);
+			m_buffer_prev = buffer;
+			m_frames_swap = m_frames;
+			buffer = buffer_next;
+		}
+		// disabled: release buffers
+		if (wet < 1E-9f) {
+			if (m_buffer_prev) {
+				if (release_buffer(m_buffer_prev))
+					m_buffer_prev = nullptr;
+			}
+			else
+			if (buffer && release_buffer(buffer)) {
+				m_buffer.store(nullptr, std::memory_order_release);
+				m_nsize_req.store(0, std::memory_order_relaxed);
+			}
+			return silent;
+		}
 		// constrained feedback
 		feedb *= 0.95f;
 		// calculate delay time
@@ -487,32 +912,143 @@ public:
 		// set integer delay
 		uint32_t ndelay = uint32_t(delay_time);
 		// clamp
+		const uint32_t max_size = maxSize();
 		if (ndelay < MIN_SIZE)
 			ndelay = MIN_SIZE;
 		else
-		if (ndelay > MAX_SIZE)
-			ndelay = MAX_SIZE;
+		if (ndelay > max_size)
+			ndelay = max_size;
+		// request larger buffer, if needed
+		const uint32_t nsize = (buffer ? buffer->nsize : 0);
+		if (ndelay > nsize
+			&& ndelay > m_nsize_req.load(std::memory_order_relaxed)) {
+			m_nsize_req.store(ndelay, std::memory_order_relaxed);
+			m_sync_req.store(true, std::memory_order_release);
+		}
+		// nothing to delay with, yet
+		if (buffer == nullptr)
+			return silent;
+		// shorten while waiting for a larger buffer
+		if (ndelay > nsize)
+			ndelay = nsize;
+		// tail bypass
+		if (!m_tail.process(silent, nframes,
+				samplv1_fx_tail::frames(float(ndelay), feedb)))
+			return true;
 		// delay process
-		for (uint32_t i = 0; i < nframes; ++i) {
-			const uint32_t j = (m_frames++) & MAX_MASK;
-			m_out = m_buffer[(j - ndelay) & MAX_MASK];
-			m_buffer[j] = *in + m_out * feedb;
-			*in++ += wet * m_out;
+		float *data = buffer->data;
+		const uint32_t nmask = buffer->nmask;
+		if (m_buffer_prev) {
+			// read older frames from the previous buffer
+			const float *prev_data = m_buffer_prev->data;
+			const uint32_t prev_nsize = m_buffer_prev->nsize;
+			const uint32_t prev_nmask = m_buffer_prev->nmask;
+			for (uint32_t i = 0; i < nframes; ++i) {
+				const uint32_t t = m_frames - ndelay;
+				const uint32_t d = m_frames_swap - t;
+				if (int32_t(d) > 0)
+					m_out = (d <= prev_nsize ? prev_data[t & prev_nmask] : 0.0f);
+				else
+					m_out = data[t & nmask];
+				data[(m_frames++) & nmask] = *in + m_out * feedb;
+				*in++ += wet * m_out;
+			}
+		} else {
+			for (uint32_t i = 0; i < nframes; ++i) {
+				const uint32_t j = (m_frames++) & nmask;
+				m_out = data[(j - ndelay) & nmask];
+				data[j] = *in + m_out * feedb;
+				*in++ += wet * m_out;
+			}
 		}
+		return false;
 	}
 
+	// whether the buffers need to be synced (real-time thread).
+	bool sync_request()
+	{
+		return m_sync_req.exchange(false, std::memory_order_acquire);
+	}
+
+	// (re)allocate/release buffers (worker thread).
+	void sync_buffers()
+	{
+		Buffer *buffer_free = m_buffer_free.load(std::memory_order_acquire);
+		if (buffer_free) {
+			delete buffer_free;
+			m_buffer_free.store(nullptr, std::memory_order_release);
+		}
+
+		const uint32_t nsize_req = m_nsize_req.load(std::memory_order_relaxed);
+		Buffer *buffer = m_buffer.load(std::memory_order_acquire);
+		const uint32_t nsize = (buffer ? buffer->nsize : 0);
+		if (nsize_req > nsize
+			&& m_buffer_next.load(std::memory_order_acquire) == nullptr)
+			m_buffer_next.store(new Buffer(nsize_req), std::memory_order_release);
+	}
+
+	// maximum delay time (frames).
+	uint32_t maxSize() const
+		{ return uint32_t(MAX_DELAY_SECS * m_srate); }
+
 	static const uint32_t MIN_SIZE = (1 <<  8);	//= 256;
-	static const uint32_t MAX_SIZE = (1 << 16);	//= 65536;
-	static const uint32_t MAX_MASK = MAX_SIZE - 1;
+
+	static constexpr float MAX_DELAY_SECS = 10.0f;
+
+protected:
+
+	// power-of-two sized delay line.
+	struct Buffer
+	{
+		Buffer(uint32_t nsize_req)
+		{
+			nsize = MIN_SIZE;
+			while (nsize < nsize_req)
+				nsize <<= 1;
+			nmask = nsize - 1;
+			data = new float [nsize];
+			reset();
+		}
+
+		~Buffer() { delete [] data; }
+
+		void reset()
+			{ ::memset(data, 0, nsize * sizeof(float)); }
+
+		float   *data;
+		uint32_t nsize;
+		uint32_t nmask;
+	};
+
+	// hand over a buffer to be freed (real-time thread).
+	bool release_buffer(Buffer *buffer)
+	{
+		if (m_buffer_free.load(std::memory_order_acquire))
+			return false;
+		m_buffer_free.store(buffer, std::memory_order_release);
+		m_sync_req.store(true, std::memory_order_release);
+		return true;
+	}
 
 private:
 
 	float m_srate;
 
-	float m_buffer[MAX_SIZE];
+	std::atomic<Buffer *> m_buffer;
+	std::atomic<Buffer *> m_buffer_next;
+	std::atomic<Buffer *> m_buffer_free;
+
+	Buffer *m_buffer_prev;
+
+	std::atomic<uint32_t> m_nsize_req;
+	std::atomic<bool> m_sync_req;
+
 	float m_out;
 
 	uint32_t m_frames;
+	uint32_t m_frames_swap;
+
+	samplv1_fx_tail m_tail;
 };
 
 
@@ -561,18 +1097,25 @@ public:
 	void reset()
 	{
 		// initialize vars
-		m_lfo_phase = 0.0f;
+		m_lfo.reset();
 		m_out = 0.0f;
 		// reset taps
 		for (uint16_t n = 0; n < MAX_TAPS; ++n)
 			m_taps[n].reset();
+		// reset tail
+		m_tail.reset();
 	}
 
-	void process(float *in, uint32_t nframes, float wet,
-		float rate, float feedb, float depth, float daft)
+	bool process(float *in, uint32_t nframes, float wet,
+		float rate, float feedb, float depth, float daft,
+		bool silent = false)
 	{
 		if (wet < 1E-9f)
-			return;
+			return silent;
+		// tail bypass (allpass chain ringing ~50 msec per loop)
+		if (!m_tail.process(silent, nframes,
+				samplv1_fx_tail::frames(0.05f * m_srate, feedb)))
+			return true;
 		// daft effect
 		if (daft > 0.001f && daft < 1.0f) {
 			rate  *= (1.0f - 0.5f * daft);
@@ -585,17 +1128,13 @@ public:
 		const float delay_max = 2.0f * 4400.0f / m_srate;
 		const float lfo_inc   = 2.0f * M_PI * rate / m_srate;
 		// anti-denormal noise
-		const float adenormal = 1E-14f * samplv1_fx_randf();
+		const float adenormal = samplv1_fx_adenormal();
 		// sweep...
+		m_lfo.start(lfo_inc);
 		for (uint32_t i = 0; i < nframes; ++i) {
 			// calculate and update phaser lfo
 			const float delay = delay_min + (delay_max - delay_min)
-				* 0.5f * (1.0f + ::sinf(m_lfo_phase));
-			// increment phase
-			m_lfo_phase += lfo_inc;
-			// positive wrap phase
-			if (m_lfo_phase >= 2.0f * M_PI)
-				m_lfo_phase -= 2.0f * M_PI;
+				* 0.5f * (1.0f + m_lfo.tick());
 			// get input
 			m_out = in[i] + adenormal + m_out * feedb;
 			// update filter coeffs and calculate output
@@ -604,6 +1143,8 @@ public:
 			// output
 			in[i] += wet * m_out * depth;
 		}
+		m_lfo.finish(nframes);
+		return false;
 	}
 
 private:
@@ -614,12 +1155,9 @@ private:
 
 	samplv1_fx_allpass m_taps[MAX_TAPS];
 
-	float m_dmin;
-	float m_dmax;
-	float m_feedb;
-	float m_lfo_phase;
-	float m_lfo_inc;
-	float m_depth;
+	samplv1_fx_tail m_tail;
+
+	samplv1_fx_quad m_lfo;
 
 	float m_out;
 };
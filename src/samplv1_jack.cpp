@@ -80,6 +80,8 @@ protected:
 
 		while (m_running && poll_rc >= 0) {
 			poll_rc = ::poll(pfds, nfds, 200);
+			if (poll_rc > 0)
+				m_sampl->alsa_anchor();
 			while (poll_rc > 0) {
 				snd_seq_event_t *ev = nullptr;
 				snd_seq_event_input(seq, &ev);
@@ -172,14 +174,20 @@ samplv1_jack::samplv1_jack (const char *client_name) : samplv1(2)
 
 #ifdef CONFIG_JACK_MIDI
 	m_midi_in = nullptr;
+#ifdef CONFIG_JACK_MIDI2
+	m_midi_ump = nullptr;
+#endif
 #endif
 #ifdef CONFIG_ALSA_MIDI
 	m_alsa_seq     = nullptr;
 //	m_alsa_client  = -1;
 	m_alsa_port    = -1;
+	m_alsa_queue   = -1;
 	m_alsa_decoder = nullptr;
 	m_alsa_buffer  = nullptr;
 	m_alsa_thread  = nullptr;
+	m_alsa_anchor_time  = 0;
+	m_alsa_anchor_frame = 0;
 #endif
 
 	samplv1::programs()->enabled(true);
@@ -226,62 +234,128 @@ int samplv1_jack::process ( jack_nframes_t nframes )
 	}
 
 	uint32_t ndelta = 0;
+	uint32_t nevents = 0;
+
+	// MIDI inputs: JACK MIDI 1.0, JACK MIDI 2.0 UMP (optional) and ALSA.
+	enum { MidiIn = 0, MidiUmp = 1, MidiAlsa = 2, NumMidiIns = 3 };
+
+	uint32_t nmidi[NumMidiIns], imidi[NumMidiIns];
+	for (int m = 0; m < NumMidiIns; ++m) {
+		nmidi[m] = 0;
+		imidi[m] = 0;
+	}
 
 #ifdef CONFIG_JACK_MIDI
-	void *midi_in = ::jack_port_get_buffer(m_midi_in, nframes);
-	if (midi_in) {
-		const uint32_t nevents = ::jack_midi_get_event_count(midi_in);
-		for (uint32_t n = 0; n < nevents; ++n) {
-			jack_midi_event_t event;
-			::jack_midi_event_get(&event, midi_in, n);
-			if (event.time > ndelta) {
-				const uint32_t nread = event.time - ndelta;
-				if (nread > 0) {
-					samplv1::process(ins, outs, nread);
-					for (uint16_t k = 0; k < nchannels; ++k) {
-						ins[k]  += nread;
-						outs[k] += nread;
-					}
-				}
-				ndelta = event.time;
-			}
-			samplv1::process_midi(event.buffer, event.size);
-		}
+	void *midi_ins[2];
+	midi_ins[MidiIn] = ::jack_port_get_buffer(m_midi_in, nframes);
+	midi_ins[MidiUmp] = nullptr;
+#ifdef CONFIG_JACK_MIDI2
+	if (m_midi_ump)
+		midi_ins[MidiUmp] = ::jack_port_get_buffer(m_midi_ump, nframes);
+#endif
+	for (int m = MidiIn; m <= MidiUmp; ++m) {
+		if (midi_ins[m])
+			nmidi[m] = ::jack_midi_get_event_count(midi_ins[m]);
 	}
 #endif
 #ifdef CONFIG_ALSA_MIDI
+	// decode ALSA MIDI events into their own (time-sorted) list;
+	// whatever doesn't fit is left for the next cycle...
 	const jack_nframes_t buffer_size = ::jack_get_buffer_size(m_client);
 	const jack_nframes_t frame_time  = ::jack_last_frame_time(m_client);
-	uint8_t event_buffer[1024];
+	jack_nframes_t alsa_time = 0;
+	uint32_t ndata = 0;
 	jack_midi_event_t event;
-	while (::jack_ringbuffer_peek(m_alsa_buffer,
+	while (nmidi[MidiAlsa] < MAX_EVENTS
+		&& ::jack_ringbuffer_peek(m_alsa_buffer,
 			(char *) &event, sizeof(event)) == sizeof(event)) {
 		if (event.time > frame_time)
 			break;
+		if (event.size <= MAX_EVENT_DATA
+			&& ndata + event.size > MAX_EVENT_DATA)
+			break;
 		jack_nframes_t event_time = frame_time - event.time;
 		if (event_time > buffer_size)
 			event_time = 0;
 		else
 			event_time = buffer_size - event_time;
-		if (event_time > ndelta) {
+		if (event_time < alsa_time)
+			event_time = alsa_time;
+		::jack_ringbuffer_read_advance(m_alsa_buffer, sizeof(event));
+		if (event.size > MAX_EVENT_DATA) {
+			::jack_ringbuffer_read_advance(m_alsa_buffer, event.size);
+			continue;
+		}
+		uint8_t *data = &m_event_data[ndata];
+		::jack_ringbuffer_read(m_alsa_buffer, (char *) data, event.size);
+		ndata += event.size;
+		samplv1_event& ev = m_alsa_events[nmidi[MidiAlsa]++];
+		ev.frame = event_time;
+		ev.size  = event.size;
+		ev.data  = data;
+		ev.ump   = false;
+		alsa_time = event_time;
+	}
+#endif
+
+	// merge all (time-sorted) event lists, in frame order...
+	samplv1_event midi_evs[NumMidiIns];
+	bool midi_have[NumMidiIns];
+	for (int m = 0; m < NumMidiIns; ++m)
+		midi_have[m] = false;
+	for (;;) {
+		// next event of each input...
+		for (int m = 0; m < NumMidiIns; ++m) {
+			if (midi_have[m] || imidi[m] >= nmidi[m])
+				continue;
+		#ifdef CONFIG_ALSA_MIDI
+			if (m == MidiAlsa)
+				midi_evs[m] = m_alsa_events[imidi[m]];
+		#endif
+		#ifdef CONFIG_JACK_MIDI
+			if (m != MidiAlsa) {
+				jack_midi_event_t event;
+				::jack_midi_event_get(&event, midi_ins[m], imidi[m]);
+				samplv1_event& ev = midi_evs[m];
+				ev.frame = event.time;
+				ev.size  = event.size;
+				ev.data  = event.buffer;
+				ev.ump   = (m == MidiUmp);
+			}
+		#endif
+			++imidi[m];
+			midi_have[m] = true;
+		}
+		// earliest one (first input first, on ties)...
+		int m = -1;
+		for (int i = 0; i < NumMidiIns; ++i) {
+			if (midi_have[i] && (m < 0 || midi_evs[i].frame < midi_evs[m].frame))
+				m = i;
+		}
+		if (m < 0)
+			break;
+		midi_have[m] = false;
+		const uint32_t event_time = (midi_evs[m].frame > ndelta
+			? midi_evs[m].frame : ndelta);
+		// event-list full: process it up to here...
+		if (nevents >= MAX_EVENTS) {
 			const uint32_t nread = event_time - ndelta;
-			if (nread > 0) {
-				samplv1::process(ins, outs, nread);
-				for (uint16_t k = 0; k < nchannels; ++k) {
-					ins[k]  += nread;
-					outs[k] += nread;
-				}
+			samplv1::process(ins, outs, nread, m_events, nevents);
+			for (uint16_t k = 0; k < nchannels; ++k) {
+				ins[k]  += nread;
+				outs[k] += nread;
 			}
 			ndelta = event_time;
+			nevents = 0;
 		}
-		::jack_ringbuffer_read_advance(m_alsa_buffer, sizeof(event));
-		::jack_ringbuffer_read(m_alsa_buffer, (char *) event_buffer, event.size);
-		samplv1::process_midi(event_buffer, event.size);
+		samplv1_event& ev = m_events[nevents++];
+		ev = midi_evs[m];
+		ev.frame = event_time - ndelta;
 	}
-#endif // CONFIG_ALSA_MIDI
 
-	if (nframes > ndelta)
-		samplv1::process(ins, outs, nframes - ndelta);
+	// voices are split at event offsets, effects run once.
+	samplv1::process(ins, outs,
+		(nframes > ndelta ? nframes - ndelta : 0), m_events, nevents);
 
 	return 0;
 }
@@ -337,24 +411,50 @@ void samplv1_jack::open ( const char *client_name )
 #ifdef CONFIG_JACK_MIDI
 	m_midi_in = ::jack_port_register(m_client,
 		"in", JACK_DEFAULT_MIDI_TYPE, JackPortIsInput, 0);
+#ifdef CONFIG_JACK_MIDI2
+	m_midi_ump = ::jack_port_register(m_client,
+		"in_ump", JACK_DEFAULT_MIDI_TYPE, JackPortIsInput | JackPortIsMIDI2, 0);
+#endif
 #endif
 #ifdef CONFIG_ALSA_MIDI
 	m_alsa_seq     = nullptr;
 //	m_alsa_client  = -1;
 	m_alsa_port    = -1;
+	m_alsa_queue   = -1;
 	m_alsa_decoder = nullptr;
 	m_alsa_buffer  = nullptr;
 	m_alsa_thread  = nullptr;
+	m_alsa_anchor_time  = 0;
+	m_alsa_anchor_frame = 0;
 	// open alsa sequencer client...
-	if (snd_seq_open(&m_alsa_seq, "hw", SND_SEQ_OPEN_INPUT, 0) >= 0) {
+	if (snd_seq_open(&m_alsa_seq, "hw", SND_SEQ_OPEN_DUPLEX, 0) >= 0) {
 		snd_seq_set_client_name(m_alsa_seq, client_name);
 	//	m_alsa_client = snd_seq_client_id(m_alsa_seq);
-		m_alsa_port = snd_seq_create_simple_port(m_alsa_seq, "in",
-			SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE,
+		// input events get real-time stamped on arrival,
+		// by our own (running) queue...
+		m_alsa_queue = snd_seq_alloc_queue(m_alsa_seq);
+		snd_seq_port_info_t *pinfo;
+		snd_seq_port_info_alloca(&pinfo);
+		snd_seq_port_info_set_name(pinfo, "in");
+		snd_seq_port_info_set_capability(pinfo,
+			SND_SEQ_PORT_CAP_WRITE | SND_SEQ_PORT_CAP_SUBS_WRITE);
+		snd_seq_port_info_set_type(pinfo,
 			SND_SEQ_PORT_TYPE_MIDI_GENERIC | SND_SEQ_PORT_TYPE_APPLICATION);
+		if (m_alsa_queue >= 0) {
+			snd_seq_port_info_set_timestamping(pinfo, 1);
+			snd_seq_port_info_set_timestamp_real(pinfo, 1);
+			snd_seq_port_info_set_timestamp_queue(pinfo, m_alsa_queue);
+		}
+		if (snd_seq_create_port(m_alsa_seq, pinfo) >= 0)
+			m_alsa_port = snd_seq_port_info_get_port(pinfo);
+		if (m_alsa_queue >= 0) {
+			snd_seq_start_queue(m_alsa_seq, m_alsa_queue, nullptr);
+			snd_seq_drain_output(m_alsa_seq);
+		}
 		snd_midi_event_new(1024, &m_alsa_decoder);
 		m_alsa_buffer = ::jack_ringbuffer_create(
 			1024 * (sizeof(jack_midi_event_t) + 4));
+		::jack_ringbuffer_mlock(m_alsa_buffer);
 		m_alsa_thread = new samplv1_alsa_thread(this);
 		m_alsa_thread->start(QThread::TimeCriticalPriority);
 	}
@@ -430,6 +530,12 @@ void samplv1_jack::close (void)
 			snd_seq_delete_simple_port(m_alsa_seq, m_alsa_port);
 			m_alsa_port = -1;
 		}
+		if (m_alsa_queue >= 0) {
+			snd_seq_stop_queue(m_alsa_seq, m_alsa_queue, nullptr);
+			snd_seq_drain_output(m_alsa_seq);
+			snd_seq_free_queue(m_alsa_seq, m_alsa_queue);
+			m_alsa_queue = -1;
+		}
 		snd_seq_close(m_alsa_seq);
 	//	m_alsa_client = -1;
 		m_alsa_seq = nullptr;
@@ -445,6 +551,12 @@ void samplv1_jack::close (void)
 		::jack_port_unregister(m_client, m_midi_in);
 		m_midi_in = nullptr;
 	}
+#ifdef CONFIG_JACK_MIDI2
+	if (m_midi_ump) {
+		::jack_port_unregister(m_client, m_midi_ump);
+		m_midi_ump = nullptr;
+	}
+#endif
 #endif
 
 	// unregister audio ports
@@ -498,6 +610,50 @@ snd_seq_t *samplv1_jack::alsa_seq (void) const
 }
 
 // alsa event capture.
+// ALSA queue real-time to JACK frame time anchor (capture thread).
+void samplv1_jack::alsa_anchor (void)
+{
+	if (m_alsa_queue < 0)
+		return;
+
+	snd_seq_queue_status_t *status;
+	snd_seq_queue_status_alloca(&status);
+	if (snd_seq_get_queue_status(m_alsa_seq, m_alsa_queue, status) < 0)
+		return;
+
+	const snd_seq_real_time_t *rt
+		= snd_seq_queue_status_get_real_time(status);
+	m_alsa_anchor_frame = ::jack_frame_time(m_client);
+	m_alsa_anchor_time  = int64_t(rt->tv_sec) * 1000000000LL + rt->tv_nsec;
+}
+
+
+// ALSA event arrival time, in JACK frame time (capture thread).
+jack_nframes_t samplv1_jack::alsa_frame_time ( snd_seq_event_t *ev ) const
+{
+	if (m_alsa_queue < 0 || m_alsa_anchor_time < 1
+		|| (ev->flags & SND_SEQ_TIME_STAMP_MASK) != SND_SEQ_TIME_STAMP_REAL)
+		return ::jack_frame_time(m_client);
+
+	// how long ago it did arrive, on the very same (ALSA) clock:
+	// the anchor is renewed on every wake-up, so drift between
+	// the ALSA and JACK clocks never gets to accumulate.
+	const int64_t ev_time
+		= int64_t(ev->time.time.tv_sec) * 1000000000LL + ev->time.time.tv_nsec;
+	int64_t lag = m_alsa_anchor_time - ev_time;
+	if (lag < 0)
+		lag = 0;
+	else
+	if (lag > 1000000000LL) // 1 sec. max.
+		lag = 1000000000LL;
+
+	const jack_nframes_t nlag = jack_nframes_t(
+		float(lag) * 1E-9f * samplv1::sampleRate());
+
+	return m_alsa_anchor_frame - nlag;
+}
+
+
 void samplv1_jack::alsa_capture ( snd_seq_event_t *ev )
 {
 	if (m_alsa_decoder == nullptr)
@@ -561,7 +717,7 @@ void samplv1_jack::alsa_capture ( snd_seq_event_t *ev )
 			ev_data, nlimit - sizeof(jack_midi_event_t), ev);
 		if (ev_size > 0) {
 			jack_midi_event_t *ev_head = (jack_midi_event_t *) &ev_buff[0];
-			ev_head->time = ::jack_frame_time(m_client);
+			ev_head->time = alsa_frame_time(ev);
 			ev_head->size = ev_size;
 			ev_head->buffer = (jack_midi_data_t *) ev_data;
 			::jack_ringbuffer_write(m_alsa_buffer,
@@ -59,6 +59,7 @@ public:
 
 #ifdef CONFIG_ALSA_MIDI
 	snd_seq_t *alsa_seq() const;
+	void alsa_anchor();
 	void alsa_capture(snd_seq_event_t *ev);
 #endif
 
@@ -86,6 +87,11 @@ protected:
 
 	void updateTuning();
 
+#ifdef CONFIG_ALSA_MIDI
+	// ALSA event arrival time, in JACK frame time.
+	jack_nframes_t alsa_frame_time(snd_seq_event_t *ev) const;
+#endif
+
 private:
 
 	jack_client_t *m_client;
@@ -100,16 +106,37 @@ private:
 
 	float m_params[samplv1::NUM_PARAMS];
 
+	// per process() cycle MIDI event-list.
+	static const uint32_t MAX_EVENTS = 1024;
+
+	samplv1_event m_events[MAX_EVENTS];
+
 #ifdef CONFIG_JACK_MIDI
 	jack_port_t *m_midi_in;
+#ifdef CONFIG_JACK_MIDI2
+	jack_port_t *m_midi_ump;
+#endif
 #endif
 #ifdef CONFIG_ALSA_MIDI
 	snd_seq_t *m_alsa_seq;
 //	int m_alsa_client;
 	int m_alsa_port;
+	int m_alsa_queue;
 	snd_midi_event_t *m_alsa_decoder;
 	jack_ringbuffer_t *m_alsa_buffer;
 	samplv1_alsa_thread *m_alsa_thread;
+
+	// ALSA queue real-time (nsecs) vs. JACK frame time anchor.
+	int64_t m_alsa_anchor_time;
+	jack_nframes_t m_alsa_anchor_frame;
+
+	// ALSA MIDI event-list, merged into the one above.
+	samplv1_event m_alsa_events[MAX_EVENTS];
+
+	// ALSA MIDI event data, copied over for the event-list.
+	static const uint32_t MAX_EVENT_DATA = 8192;
+
+	uint8_t m_event_data[MAX_EVENT_DATA];
 #endif
 };
 
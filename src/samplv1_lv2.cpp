@@ -102,9 +102,12 @@ samplv1_lv2::samplv1_lv2 (
 	m_urid_map = nullptr;
 	m_atom_in  = nullptr;
 	m_atom_out = nullptr;
+	m_latency  = nullptr;
 	m_schedule = nullptr;
 	m_ndelta   = 0;
 
+	m_sample_pending = 0;
+
 #ifdef CONFIG_LV2_PORT_CHANGE_REQUEST
 	m_port_change_request = nullptr;
 #endif
@@ -164,6 +167,8 @@ samplv1_lv2::samplv1_lv2 (
 					m_urid_map->handle, SAMPLV1_LV2_PREFIX "P205_TUNING_KEYMAP_FILE");
 				m_urids.tun1_update = m_urid_map->map(
 					m_urid_map->handle, SAMPLV1_LV2_PREFIX "TUN1_UPDATE");
+				m_urids.p301_reverb_file = m_urid_map->map(
+					m_urid_map->handle, SAMPLV1_LV2_PREFIX "P301_REVERB_FILE");
 				m_urids.atom_Blank = m_urid_map->map(
 					m_urid_map->handle, LV2_ATOM__Blank);
 				m_urids.atom_Object = m_urid_map->map(
@@ -188,8 +193,8 @@ samplv1_lv2::samplv1_lv2 (
 					m_urid_map->handle, LV2_TIME__beatsPerMinute);
 				m_urids.midi_MidiEvent = m_urid_map->map(
 					m_urid_map->handle, LV2_MIDI__MidiEvent);
-				m_urids.midi_MidiEvent = m_urid_map->map(
-					m_urid_map->handle, LV2_MIDI__MidiEvent);
+				m_urids.midi_UmpEvent = m_urid_map->map(
+					m_urid_map->handle, SAMPLV1_LV2_PREFIX "UMP_EVENT");
 				m_urids.bufsz_minBlockLength = m_urid_map->map(
 					m_urid_map->handle, LV2_BUF_SIZE__minBlockLength);
 				m_urids.bufsz_maxBlockLength = m_urid_map->map(
@@ -287,6 +292,9 @@ void samplv1_lv2::connect_port ( uint32_t port, void *data )
 	case AudioOutR:
 		m_outs[1] = (float *) data;
 		break;
+	case Latency:
+		m_latency = (float *) data;
+		break;
 	default:
 		samplv1::setParamPort(samplv1::ParamIndex(port - ParamBase), (float *) data);
 		break;
@@ -310,31 +318,59 @@ void samplv1_lv2::run ( uint32_t nframes )
 	}
 
 	uint32_t ndelta = 0;
+	uint32_t noffset = 0;
+	uint32_t nevents = 0;
 
 	if (m_atom_in) {
 		LV2_ATOM_SEQUENCE_FOREACH(m_atom_in, event) {
 			if (event == nullptr)
 				continue;
-			if (event->body.type == m_urids.midi_MidiEvent) {
+			if (event->body.type == m_urids.midi_MidiEvent ||
+				event->body.type == m_urids.midi_UmpEvent) {
 				uint8_t *data = (uint8_t *) LV2_ATOM_BODY(&event->body);
-				if (event->time.frames > ndelta) {
-					const uint32_t nread = event->time.frames - ndelta;
-					if (nread > 0) {
-						samplv1::process(ins, outs, nread);
-						for (uint16_t k = 0; k < nchannels; ++k) {
-							ins[k]  += nread;
-							outs[k] += nread;
-						}
+				ndelta = event->time.frames;
+				if (ndelta < noffset)
+					ndelta = noffset;
+				// event-list full: process it up to here...
+				if (nevents >= MAX_EVENTS) {
+					const uint32_t nread = ndelta - noffset;
+					samplv1::process(ins, outs, nread, m_events, nevents);
+					for (uint16_t k = 0; k < nchannels; ++k) {
+						ins[k]  += nread;
+						outs[k] += nread;
 					}
+					noffset = ndelta;
+					nevents = 0;
 				}
-				ndelta = event->time.frames;
-				samplv1::process_midi(data, event->body.size);
+				samplv1_event& ev = m_events[nevents++];
+				ev.frame = ndelta - noffset;
+				ev.size  = event->body.size;
+				ev.data  = data;
+				ev.ump   = (event->body.type == m_urids.midi_UmpEvent);
 			}
 			else
 			if (event->body.type == m_urids.atom_Blank ||
 				event->body.type == m_urids.atom_Object) {
 				const LV2_Atom_Object *object
 					= (LV2_Atom_Object *) &event->body;
+				// pending MIDI events go first: process them up to here...
+				if (nevents > 0 && (object->body.otype == m_urids.time_Position
+				#ifdef CONFIG_LV2_PATCH
+					|| object->body.otype == m_urids.patch_Set
+				#endif
+					)) {
+					ndelta = event->time.frames;
+					if (ndelta < noffset)
+						ndelta = noffset;
+					const uint32_t nread = ndelta - noffset;
+					samplv1::process(ins, outs, nread, m_events, nevents);
+					for (uint16_t k = 0; k < nchannels; ++k) {
+						ins[k]  += nread;
+						outs[k] += nread;
+					}
+					noffset = ndelta;
+					nevents = 0;
+				}
 				if (object->body.otype == m_urids.time_Position) {
 					LV2_Atom *atom = nullptr;
 					lv2_atom_object_get(object,
@@ -368,9 +404,18 @@ void samplv1_lv2::run ( uint32_t nframes )
 								mesg.atom.size = sizeof(mesg.data.path);
 								mesg.data.path
 									= (const char *) LV2_ATOM_BODY_CONST(value);
+								// cancel any sample still loading...
+								const bool pending
+									= (key == m_urids.p101_sample_file);
+								if (pending) {
+									samplv1::cancelSampleFile();
+									++m_sample_pending;
+								}
 								// schedule loading new sample
-								m_schedule->schedule_work(
-									m_schedule->handle, sizeof(mesg), &mesg);
+								if (m_schedule->schedule_work(
+										m_schedule->handle, sizeof(mesg), &mesg)
+										!= LV2_WORKER_SUCCESS && pending)
+									--m_sample_pending;
 							}
 						}
 						else
@@ -518,6 +563,20 @@ void samplv1_lv2::run ( uint32_t nframes )
 							samplv1::setTuningKeyMapFile(keyMapFile);
 							updateTuning();
 						}
+						else
+						if (key == m_urids.p301_reverb_file
+							&& type == m_urids.atom_Path) {
+							if (m_schedule) {
+								samplv1_lv2_worker_message mesg;
+								mesg.atom.type = key;
+								mesg.atom.size = sizeof(mesg.data.path);
+								mesg.data.path
+									= (const char *) LV2_ATOM_BODY_CONST(value);
+								// schedule loading new impulse response
+								m_schedule->schedule_work(
+									m_schedule->handle, sizeof(mesg), &mesg);
+							}
+						}
 					}
 				}
 				else
@@ -539,11 +598,16 @@ void samplv1_lv2::run ( uint32_t nframes )
 	//	m_atom_in = nullptr;
 	}
 
-	if (nframes > ndelta)
-		samplv1::process(ins, outs, nframes - ndelta);
+	// voices are split at event offsets, effects run once.
+	samplv1::process(ins, outs,
+		(nframes > noffset ? nframes - noffset : 0), m_events, nevents);
 
 	// test for sample offset/loop changes
 	samplv1::sampleOffsetLoopTest();
+
+	// report processing latency
+	if (m_latency)
+		*m_latency = float(samplv1::latency());
 }
 
 
@@ -652,7 +716,26 @@ static LV2_State_Status samplv1_lv2_state_save ( LV2_Handle instance,
 #else
 	flags |= (LV2_STATE_IS_POD | LV2_STATE_IS_PORTABLE);
 #endif
-	const char *value = pPlugin->sampleFile();
+
+	// Reverb impulse response file, if any...
+	const char *value = pPlugin->reverbFile();
+	if (value) {
+		const uint32_t reverb_key
+			= pPlugin->urid_map(SAMPLV1_LV2_PREFIX "P301_REVERB_FILE");
+		if (map_path)
+			value = (*map_path->abstract_path)(map_path->handle, value);
+		if (value && reverb_key)
+			(*store)(handle, reverb_key, value, ::strlen(value) + 1, type, flags);
+	#ifdef CONFIG_LV2_STATE_FREE_PATH
+		if (value && free_path)
+			free_path->free_path(free_path->handle, (char *) value);
+		else
+	#endif
+		if (value && map_path)
+			::free((void *) value);
+	}
+
+	value = pPlugin->sampleFile();
 
 	if (value && map_path)
 		value = (*map_path->abstract_path)(map_path->handle, value);
@@ -810,8 +893,34 @@ static LV2_State_Status samplv1_lv2_state_restore ( LV2_Handle instance,
 	uint32_t type = 0;
 //	flags = 0;
 
-	const char *value
-		= (const char *) (*retrieve)(handle, key, &size, &type, &flags);
+	// Reverb impulse response file, if any...
+	const uint32_t reverb_key
+		= pPlugin->urid_map(SAMPLV1_LV2_PREFIX "P301_REVERB_FILE");
+	const char *value = nullptr;
+	if (reverb_key)
+		value = (const char *) (*retrieve)(handle, reverb_key, &size, &type, &flags);
+	if (value && size > 1 && (type == string_type || type == path_type)) {
+		if (map_path)
+			value = (*map_path->absolute_path)(map_path->handle, value);
+		if (value) {
+			const QString sReverbFile
+				= QFileInfo(QString::fromUtf8(value)).canonicalFilePath();
+		#ifdef CONFIG_LV2_STATE_FREE_PATH
+			if (free_path)
+				free_path->free_path(free_path->handle, (char *) value);
+			else
+		#endif
+			if (map_path)
+				::free((void *) value);
+			pPlugin->setReverbFile(sReverbFile.toUtf8().constData());
+		}
+	} else {
+		pPlugin->setReverbFile(nullptr);
+	}
+
+	size = 0;
+	type = 0;
+	value = (const char *) (*retrieve)(handle, key, &size, &type, &flags);
 #if 1//SAMPLV1_LV2_LEGACY
 	if (value == nullptr) {
 		key = pPlugin->urid_map(SAMPLV1_LV2_PREFIX "GEN1_SAMPLE");
@@ -1247,14 +1356,20 @@ bool samplv1_lv2::worker_work ( const void *data, uint32_t size )
 	const samplv1_lv2_worker_message *mesg
 		= (const samplv1_lv2_worker_message *) data;
 
-	if (mesg->atom.type == m_urids.p101_sample_file)
-		samplv1::setSampleFile(mesg->data.path, samplv1::octaves());
+	if (mesg->atom.type == m_urids.p101_sample_file) {
+		// coalesce: only the latest pending one gets loaded.
+		if (--m_sample_pending == 0)
+			samplv1::setSampleFile(mesg->data.path, samplv1::octaves());
+	}
 	else
 	if (mesg->atom.type == m_urids.p108_sample_otabs)
 		samplv1::setSampleFile(samplv1::sampleFile(), mesg->data.key);
 	else
 	if (mesg->atom.type == m_urids.tun1_update)
 		samplv1::resetTuning();
+	else
+	if (mesg->atom.type == m_urids.p301_reverb_file)
+		samplv1::setReverbFile(mesg->data.path);
 
 	return true;
 }
@@ -1376,6 +1491,13 @@ bool samplv1_lv2::patch_set ( LV2_URID key )
 			pszKeyMapFile = s_szNull;
 		lv2_atom_forge_path(&m_forge, pszKeyMapFile, ::strlen(pszKeyMapFile) + 1);
 	}
+	else
+	if (key == m_urids.p301_reverb_file) {
+		const char *pszReverbFile = samplv1::reverbFile();
+		if (pszReverbFile == nullptr)
+			pszReverbFile = s_szNull;
+		lv2_atom_forge_path(&m_forge, pszReverbFile, ::strlen(pszReverbFile) + 1);
+	}
 
 	lv2_atom_forge_pop(&m_forge, &patch_frame);
 
@@ -1406,6 +1528,9 @@ bool samplv1_lv2::patch_get ( LV2_URID key )
 		if (key) return true;
 	}
 
+	if (key == 0)
+		patch_set(m_urids.p301_reverb_file);
+
 	if (key) patch_set(key);
 
 	return true;
@@ -50,6 +50,8 @@
 #include "lv2_port_change_request.h"
 #endif
 
+#include <atomic>
+
 // Forward decls.
 class QApplication;
 
@@ -74,7 +76,8 @@ public:
 		AudioInR,
 		AudioOutL,
 		AudioOutR,
-		ParamBase
+		ParamBase,
+		Latency = ParamBase + samplv1::NUM_PARAMS
 	};
 
 	void connect_port(uint32_t port, void *data);
@@ -163,6 +166,7 @@ private:
 		LV2_URID p204_tuning_scaleFile;
 		LV2_URID p205_tuning_keyMapFile;
 		LV2_URID tun1_update;
+		LV2_URID p301_reverb_file;
 		LV2_URID atom_Blank;
 		LV2_URID atom_Object;
 		LV2_URID atom_Float;
@@ -176,6 +180,7 @@ private:
 		LV2_URID time_Position;
 		LV2_URID time_beatsPerMinute;
 		LV2_URID midi_MidiEvent;
+		LV2_URID midi_UmpEvent;
 		LV2_URID bufsz_minBlockLength;
 		LV2_URID bufsz_maxBlockLength;
 		LV2_URID bufsz_nominalBlockLength;
@@ -193,6 +198,9 @@ private:
 
 	LV2_Worker_Schedule *m_schedule;
 
+	// sample file loads pending on the worker (coalescing).
+	std::atomic<uint32_t> m_sample_pending;
+
 	uint32_t m_ndelta;
 
 	LV2_Atom_Sequence *m_atom_in;
@@ -201,6 +209,13 @@ private:
 	float **m_ins;
 	float **m_outs;
 
+	float *m_latency;
+
+	// per run() cycle MIDI event-list.
+	static const uint32_t MAX_EVENTS = 1024;
+
+	samplv1_event m_events[MAX_EVENTS];
+
 #ifdef CONFIG_LV2_PROGRAMS
 	LV2_Program_Descriptor m_program;
 	QByteArray m_aProgramName;
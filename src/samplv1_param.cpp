@@ -149,7 +149,10 @@ struct ParamInfo {
 	{ "DYN1_LIMITER",  PARAM_BOOL,    1.0f,   0.0f,   1.0f }, // Dynamic Limiter
 
 	{ "KEY1_LOW",      PARAM_INT,     0.0f,   0.0f, 127.0f }, // Keyboard Low
-	{ "KEY1_HIGH",     PARAM_INT,   127.0f,   0.0f, 127.0f }  // Keyboard High
+	{ "KEY1_HIGH",     PARAM_INT,   127.0f,   0.0f, 127.0f }, // Keyboard High
+
+	{ "DCF1_OVERSAMPLE", PARAM_INT,   0.0f,   0.0f,   2.0f }, // Filter Oversampling
+	{ "LFO1_GLOBAL",   PARAM_BOOL,    0.0f,   0.0f,   1.0f }  // LFO1 Global
 };
 
 
@@ -230,12 +233,12 @@ bool samplv1_param::newPreset ( samplv1 *pSampl )
 
 	const bool running = pSampl->running(false);
 
-	samplv1_sched::sync_reset();
+	samplv1_sched::sync_reset(pSampl);
 
 	pSampl->stabilize();
 	pSampl->reset();
 
-	samplv1_sched::sync_pending();
+	samplv1_sched::sync_pending(pSampl);
 
 	pSampl->running(running);
 
@@ -270,9 +273,10 @@ bool samplv1_param::loadPreset (
 
 	const bool running = pSampl->running(false);
 
-	samplv1_sched::sync_reset();
+	samplv1_sched::sync_reset(pSampl);
 
 	pSampl->setTuningEnabled(false);
+	pSampl->setReverbFile(nullptr);
 	pSampl->reset();
 
 	static QHash<QString, samplv1::ParamIndex> s_hash;
@@ -368,7 +372,7 @@ bool samplv1_param::loadPreset (
 	pSampl->stabilize();
 	pSampl->reset();
 
-	samplv1_sched::sync_pending();
+	samplv1_sched::sync_pending(pSampl);
 
 	pSampl->running(running);
 
@@ -445,6 +449,8 @@ void samplv1_param::loadSamples (
 	if (pSampl == nullptr)
 		return;
 
+	QString sReverbFile;
+
 	for (QDomNode nSample = eSamples.firstChild();
 			!nSample.isNull();
 				nSample = nSample.nextSibling()) {
@@ -519,6 +525,30 @@ void samplv1_param::loadSamples (
 			pSampl->setLoopRange(iLoopStart, iLoopEnd);
 			pSampl->setOffsetRange(iOffsetStart, iOffsetEnd);
 		}
+		else
+		if (eSample.tagName() == "impulse") {
+			for (QDomNode nChild = eSample.firstChild();
+					!nChild.isNull();
+						nChild = nChild.nextSibling()) {
+				QDomElement eChild = nChild.toElement();
+				if (eChild.isNull())
+					continue;
+				if (eChild.tagName() == "filename") {
+					sReverbFile = mapPath.absolutePath(
+						samplv1_param::loadFilename(eChild.text()));
+				}
+			}
+		}
+	}
+
+	// Convolution reverb impulse response, if any...
+	const QString sReverbFile0
+		= QString::fromUtf8(pSampl->reverbFile());
+	if (sReverbFile != sReverbFile0) {
+		if (sReverbFile.isEmpty())
+			pSampl->setReverbFile(nullptr);
+		else
+			pSampl->setReverbFile(sReverbFile.toUtf8().constData());
 	}
 
 	// Consolidate sample state...
@@ -533,6 +563,18 @@ void samplv1_param::saveSamples (
 	if (pSampl == nullptr)
 		return;
 
+	const char *pszReverbFile = pSampl->reverbFile();
+	if (pszReverbFile) {
+		QDomElement eImpulse = doc.createElement("impulse");
+		eImpulse.setAttribute("name", "REV1_IMPULSE");
+		QDomElement eFilename = doc.createElement("filename");
+		eFilename.appendChild(doc.createTextNode(mapPath.abstractPath(
+			samplv1_param::saveFilename(
+				QString::fromUtf8(pszReverbFile), bSymLink))));
+		eImpulse.appendChild(eFilename);
+		eSamples.appendChild(eImpulse);
+	}
+
 	const char *pszSampleFile = pSampl->sampleFile();
 	if (pszSampleFile == nullptr)
 		return;
@@ -0,0 +1,269 @@
+// samplv1_pool.cpp
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#include "samplv1_pool.h"
+#include "samplv1_ftz.h"
+#include "samplv1_sem.h"
+
+#include <QThread>
+
+#if !defined(_WIN32)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#if defined(__SSE2__) || defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h>
+#define samplv1_pool_pause() _mm_pause()
+#else
+#define samplv1_pool_pause()
+#endif
+
+
+//-------------------------------------------------------------------------
+// samplv1_pool_thread - real-time worker thread.
+//
+
+class samplv1_pool_thread : public QThread
+{
+public:
+
+	// ctor.
+	samplv1_pool_thread(samplv1_pool *pool)
+		: QThread(), m_pool(pool), m_running(true),
+			m_policy(-1), m_priority(0) {}
+
+	// dtor.
+	~samplv1_pool_thread()
+	{
+		m_running.store(false);
+		m_sem.post();
+
+		wait();
+	}
+
+	// wake up (real-time safe).
+	void schedule()
+		{ m_sem.post(); }
+
+protected:
+
+	// main thread executive.
+	void run()
+	{
+		for (;;) {
+			// wait for sync...
+			m_sem.wait();
+			if (!m_running.load())
+				break;
+			// do whatever we must, as the caller would...
+			update_sched();
+			samplv1_ftz ftz(m_pool->isFtz());
+			m_pool->work();
+		}
+	}
+
+	// follow the caller's scheduling policy and priority.
+	void update_sched()
+	{
+	#if !defined(_WIN32)
+		const int policy = m_pool->policy();
+		const int priority = m_pool->priority();
+		if (policy < 0 || (policy == m_policy && priority == m_priority))
+			return;
+		m_policy = policy;
+		m_priority = priority;
+		sched_param param;
+		param.sched_priority = priority;
+		::pthread_setschedparam(::pthread_self(), policy, &param);
+	#endif
+	}
+
+private:
+
+	// instance reference.
+	samplv1_pool *m_pool;
+
+	// whether the thread is logically running.
+	std::atomic<bool> m_running;
+
+	// current scheduling policy and priority.
+	int m_policy;
+	int m_priority;
+
+	// thread synchronization objects.
+	samplv1_sem m_sem;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_pool - real-time worker thread pool (parallel-for).
+//
+
+static const uint64_t POOL_TASK_MASK  = 0xffffULL;
+static const uint32_t POOL_TASK_SHIFT = 16;
+static const uint32_t POOL_GEN_SHIFT  = 32;
+
+// barrier spins before taking over any pending tasks.
+static const uint32_t POOL_SPIN_MAX = 4096;
+
+
+// ctor.
+samplv1_pool::samplv1_pool ( uint32_t nthreads )
+	: m_claim(0), m_done(0), m_job(nullptr),
+		m_ftz(false), m_policy(-1), m_priority(0),
+		m_nthreads(nthreads), m_threads(nullptr)
+{
+	for (uint32_t i = 0; i < MaxTasks; ++i)
+		m_taken[i].store(0);
+
+	if (m_nthreads > 0) {
+		m_threads = new samplv1_pool_thread * [m_nthreads];
+		for (uint32_t i = 0; i < m_nthreads; ++i) {
+			m_threads[i] = new samplv1_pool_thread(this);
+			m_threads[i]->start(QThread::TimeCriticalPriority);
+		}
+	}
+}
+
+
+// dtor.
+samplv1_pool::~samplv1_pool (void)
+{
+	if (m_threads) {
+		for (uint32_t i = 0; i < m_nthreads; ++i)
+			delete m_threads[i];
+		delete [] m_threads;
+	}
+}
+
+
+// number of worker threads worth for ntasks.
+uint32_t samplv1_pool::threads ( uint32_t ntasks )
+{
+	const int ncores = QThread::idealThreadCount();
+	if (ncores < 2 || ntasks < 2)
+		return 0;
+
+	return (ntasks < uint32_t(ncores) ? ntasks : uint32_t(ncores)) - 1;
+}
+
+
+// run job tasks [0, ntasks) in parallel, wait for all done.
+void samplv1_pool::run ( Job *job, uint32_t ntasks )
+{
+	// tasks beyond capacity are processed serially, at last.
+	const uint32_t nserial = ntasks;
+	if (ntasks > MaxTasks)
+		ntasks = MaxTasks;
+
+	m_job.store(job, std::memory_order_relaxed);
+	m_done.store(0, std::memory_order_relaxed);
+
+	// workers shall run as the caller does...
+	m_ftz.store(samplv1_ftz::isActive(), std::memory_order_relaxed);
+#if !defined(_WIN32)
+	int policy = SCHED_OTHER;
+	sched_param param;
+	if (::pthread_getschedparam(::pthread_self(), &policy, &param) == 0) {
+		m_policy.store(policy, std::memory_order_relaxed);
+		m_priority.store(param.sched_priority, std::memory_order_relaxed);
+	}
+#endif
+
+	// new generation, publishes the job...
+	const uint64_t gen
+		= (m_claim.load(std::memory_order_relaxed) >> POOL_GEN_SHIFT) + 1;
+	m_claim.store((gen << POOL_GEN_SHIFT)
+		| (uint64_t(ntasks) << POOL_TASK_SHIFT), std::memory_order_release);
+
+	for (uint32_t i = 0; i < m_nthreads; ++i)
+		m_threads[i]->schedule();
+
+	// take part...
+	work();
+
+	// barrier: wait for tasks claimed by the workers, though only
+	// for so long: then take over the ones not started yet and
+	// yield to the ones still running (at the same priority).
+	uint32_t nspins = 0;
+	while (m_done.load(std::memory_order_acquire) < ntasks) {
+		if (++nspins < POOL_SPIN_MAX) {
+			samplv1_pool_pause();
+		}
+		else
+		if (nspins == POOL_SPIN_MAX) {
+			for (uint32_t i = 0; i < ntasks; ++i) {
+				if (take(i, uint32_t(gen)))
+					process(i);
+			}
+		}
+		else QThread::yieldCurrentThread();
+	}
+
+	for (uint32_t i = ntasks; i < nserial; ++i)
+		job->process(i);
+}
+
+
+// claim and process any pending tasks.
+void samplv1_pool::work (void)
+{
+	uint64_t claim = m_claim.load(std::memory_order_acquire);
+	for (;;) {
+		const uint32_t i = uint32_t(claim & POOL_TASK_MASK);
+		const uint32_t n = uint32_t((claim >> POOL_TASK_SHIFT) & POOL_TASK_MASK);
+		if (i >= n)
+			break;
+		// the job can't change while a task is pending...
+		if (m_claim.compare_exchange_weak(claim, claim + 1,
+				std::memory_order_acq_rel, std::memory_order_acquire)) {
+			if (take(i, uint32_t(claim >> POOL_GEN_SHIFT)))
+				process(i);
+			++claim;
+		}
+	}
+}
+
+
+// take (start) a claimed task, once per generation.
+bool samplv1_pool::take ( uint32_t i, uint32_t gen )
+{
+	uint32_t taken = m_taken[i].load(std::memory_order_acquire);
+	// serial number arithmetic: a stale (older) generation never wins.
+	while (int32_t(gen - taken) > 0) {
+		if (m_taken[i].compare_exchange_weak(taken, gen,
+				std::memory_order_acq_rel, std::memory_order_acquire))
+			return true;
+	}
+	return false;
+}
+
+
+// process a taken task.
+void samplv1_pool::process ( uint32_t i )
+{
+	m_job.load(std::memory_order_acquire)->process(i);
+	m_done.fetch_add(1, std::memory_order_release);
+}
+
+
+// end of samplv1_pool.cpp
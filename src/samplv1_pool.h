@@ -0,0 +1,120 @@
+// samplv1_pool.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __samplv1_pool_h
+#define __samplv1_pool_h
+
+#include <cstdint>
+
+#include <atomic>
+
+
+// forward decls.
+class samplv1_pool_thread;
+
+
+//-------------------------------------------------------------------------
+// samplv1_pool - real-time worker thread pool (parallel-for).
+//
+// The calling (real-time) thread takes part in the work and waits for
+// all tasks to complete before returning (barrier); worker wake-ups
+// are lock-free. Workers run with the caller's scheduling policy,
+// priority and flush-to-zero mode; after a bounded spin the caller
+// takes over any task no worker has started yet.
+//
+
+class samplv1_pool
+{
+public:
+
+	// parallel job (pure virtual).
+	class Job
+	{
+	public:
+
+		virtual ~Job() {}
+
+		virtual void process(uint32_t i) = 0;
+	};
+
+	// ctor.
+	samplv1_pool(uint32_t nthreads);
+
+	// dtor.
+	~samplv1_pool();
+
+	// number of worker threads.
+	uint32_t threads() const
+		{ return m_nthreads; }
+
+	// number of worker threads worth for ntasks.
+	static uint32_t threads(uint32_t ntasks);
+
+	// run job tasks [0, ntasks) in parallel, wait for all done.
+	void run(Job *job, uint32_t ntasks);
+
+	// claim and process any pending tasks.
+	void work();
+
+	// caller's flush-to-zero mode, for the workers.
+	bool isFtz() const
+		{ return m_ftz.load(std::memory_order_relaxed); }
+
+	// caller's scheduling policy and priority, for the workers.
+	int policy() const
+		{ return m_policy.load(std::memory_order_relaxed); }
+	int priority() const
+		{ return m_priority.load(std::memory_order_relaxed); }
+
+	// max. number of tasks run in parallel.
+	static const uint32_t MaxTasks = 256;
+
+protected:
+
+	// take (start) a claimed task, once per generation.
+	bool take(uint32_t i, uint32_t gen);
+
+	// process a taken task.
+	void process(uint32_t i);
+
+private:
+
+	// claim word: generation (hi), ntasks (mid), next task (lo).
+	std::atomic<uint64_t> m_claim;
+	std::atomic<uint32_t> m_done;
+
+	// generation each task was last taken (started) in.
+	std::atomic<uint32_t> m_taken[MaxTasks];
+
+	std::atomic<Job *> m_job;
+
+	std::atomic<bool> m_ftz;
+	std::atomic<int>  m_policy;
+	std::atomic<int>  m_priority;
+
+	uint32_t m_nthreads;
+	samplv1_pool_thread **m_threads;
+};
+
+
+#endif	// __samplv1_pool_h
+
+// end of samplv1_pool.h
@@ -21,6 +21,8 @@
 
 #include "samplv1_pshifter.h"
 
+#include <QMutex>
+
 
 //---------------------------------------------------------------------------
 // samplv1_pshifter - Pitch-shift processor.
@@ -221,6 +223,30 @@ void smbFft ( float *pframes, uint32_t nframes, int sign )
 
 #endif	// CONFIG_FFTW3
 
+#ifdef CONFIG_FFTW3
+
+//---------------------------------------------------------------------------
+// samplv1_fftw_plan_lock - fftwf planner lock (scoped).
+//
+
+static QMutex g_fftw_plan_mutex;
+
+// Constructor.
+samplv1_fftw_plan_lock::samplv1_fftw_plan_lock (void)
+{
+	g_fftw_plan_mutex.lock();
+}
+
+
+// Destructor.
+samplv1_fftw_plan_lock::~samplv1_fftw_plan_lock (void)
+{
+	g_fftw_plan_mutex.unlock();
+}
+
+#endif	// CONFIG_FFTW3
+
+
 //---------------------------------------------------------------------------
 // samplv1_smbernsee_pshifter - S.M.Bernsee pitch-shift processor.
 //
@@ -266,6 +292,7 @@ samplv1_smbernsee_pshifter::samplv1_smbernsee_pshifter (
 
 #ifdef CONFIG_FFTW3
 	// create plans
+	samplv1_fftw_plan_lock lock;
 	m_aplan = ::fftwf_plan_r2r_1d(nsize, m_idata, m_odata, FFTW_R2HC, FFTW_ESTIMATE);
 	m_splan = ::fftwf_plan_r2r_1d(nsize, m_idata, m_odata, FFTW_HC2R, FFTW_ESTIMATE);
 #endif
@@ -281,8 +308,11 @@ samplv1_smbernsee_pshifter::~samplv1_smbernsee_pshifter (void)
 {
 #ifdef CONFIG_FFTW3
 	// destroy plans
-	::fftwf_destroy_plan(m_splan);
-	::fftwf_destroy_plan(m_aplan);
+	{
+		samplv1_fftw_plan_lock lock;
+		::fftwf_destroy_plan(m_splan);
+		::fftwf_destroy_plan(m_aplan);
+	}
 #endif
 	// de-allocate working arrays
 	delete [] m_smagn;
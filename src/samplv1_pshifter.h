@@ -93,6 +93,29 @@ public:
 #endif	// CONFIG_LIBRUBBERBAND
 
 
+#ifdef CONFIG_FFTW3
+
+//---------------------------------------------------------------------------
+// samplv1_fftw_plan_lock - fftwf planner lock (scoped).
+//
+// fftwf plan creation and destruction are not thread-safe; this one
+// lock is shared by all fftwf users (pitch-shifter and convolver).
+//
+
+class samplv1_fftw_plan_lock
+{
+public:
+
+	// Constructor.
+	samplv1_fftw_plan_lock();
+
+	// Destructor.
+	~samplv1_fftw_plan_lock();
+};
+
+#endif	// CONFIG_FFTW3
+
+
 //---------------------------------------------------------------------------
 // samplv1_smbernsee_pshifter - S.M.Bernsee pitch-shift processor.
 //
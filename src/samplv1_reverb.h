@@ -24,6 +24,7 @@
 
 #include <cstdint>
 #include <cstring>
+#include <cmath>
 
 
 //-------------------------------------------------------------------------
@@ -38,8 +39,8 @@ class samplv1_reverb
 public:
 
 	samplv1_reverb (float srate = 44100.0f)
-		: m_srate(srate), m_room(0.5f), m_damp(0.5f), m_feedb(0.5f)
-			{ reset(); }
+		: m_srate(srate), m_room(0.5f), m_damp(0.5f), m_feedb(0.5f),
+			m_nblock(BLOCK_SIZE), m_tail(0) { reset(); }
 
 	void setSampleRate(float srate)
 		{ m_srate = srate; }
@@ -64,23 +65,34 @@ public:
 			m_allpass1[j].reset();
 		}
 
+		m_nblock = BLOCK_SIZE;
+
 		for (j = 0; j < NUM_COMBS; ++j) {
-			m_comb0[j].resize(uint32_t(s_comb[j] * sr));
-			m_comb0[j].reset();
-			m_comb1[j].resize(uint32_t((s_comb[j] + STEREO_SPREAD) * sr));
-			m_comb1[j].reset();
+			const uint32_t size0 = uint32_t(s_comb[j] * sr);
+			const uint32_t size1 = uint32_t((s_comb[j] + STEREO_SPREAD) * sr);
+			m_combs0.resize(j, size0);
+			m_combs1.resize(j, size1);
+			// block-wise combs must not read what they write back.
+			if (m_nblock > size0)
+				m_nblock = (size0 > 0 ? size0 : 1);
 		}
 
+		m_combs0.reset();
+		m_combs1.reset();
+
+		m_tail = 0;
+
 		reset_feedb();
 		reset_room();
 		reset_damp();
 	}
 
-	void process(float *in0, float *in1, uint32_t nframes,
-		float wet, float feedb, float room, float damp, float width)
+	bool process(float *in0, float *in1, uint32_t nframes,
+		float wet, float feedb, float room, float damp, float width,
+		bool silent = false)
 	{
 		if (wet < 1E-9f)
-			return;
+			return silent;
 
 		if (m_feedb != feedb) {
 			m_feedb  = feedb;
@@ -97,37 +109,61 @@ public:
 			reset_damp();
 		}
 
-		uint32_t i, j;
+		// tail bypass (silence propagation)
+		if (!silent)
+			m_tail = tail();
+		else
+		if (m_tail > 0)
+			m_tail = (m_tail > nframes ? m_tail - nframes : 0);
+		else
+			return true;
 
-		for (i = 0; i < nframes; ++i) {
+		float out0[BLOCK_SIZE];
+		float out1[BLOCK_SIZE];
+		float tmp0[BLOCK_SIZE];
+		float tmp1[BLOCK_SIZE];
 
-			float out0 = *in0 * 0.05f; // 0.015f;
-			float out1 = *in1 * 0.05f; // 0.015f;
+		uint32_t i, j;
+
+		while (nframes > 0) {
 
-			float tmp0 = 0.0f;
-			float tmp1 = 0.0f;
+			uint32_t nblock = nframes;
+			if (nblock > m_nblock)
+				nblock = m_nblock;
 
-			for (j = 0; j < NUM_COMBS; ++j) {
-				tmp0 += m_comb0[j].output(out0);
-				tmp1 += m_comb1[j].output(out1);
+			for (i = 0; i < nblock; ++i) {
+				out0[i] = in0[i] * 0.05f; // 0.015f;
+				out1[i] = in1[i] * 0.05f; // 0.015f;
 			}
 
+			m_combs0.process(out0, tmp0, nblock);
+			m_combs1.process(out1, tmp1, nblock);
+
 			for (j = 0; j < NUM_ALLPASSES; ++j) {
-				tmp0 = m_allpass0[j].output(tmp0);
-				tmp1 = m_allpass1[j].output(tmp1);
+				m_allpass0[j].process(tmp0, nblock);
+				m_allpass1[j].process(tmp1, nblock);
 			}
 
 			if (width < 0.0f) {
-				out0 = tmp0 * (1.0f + width) - tmp1 * width;
-				out1 = tmp1 * (1.0f + width) - tmp0 * width;
+				const float width1 = 1.0f + width;
+				for (i = 0; i < nblock; ++i) {
+					in0[i] += wet * (tmp0[i] * width1 - tmp1[i] * width);
+					in1[i] += wet * (tmp1[i] * width1 - tmp0[i] * width);
+				}
 			} else {
-				out0 = tmp0 * width + tmp1 * (1.0f - width);
-				out1 = tmp1 * width + tmp0 * (1.0f - width);
+				const float width1 = 1.0f - width;
+				for (i = 0; i < nblock; ++i) {
+					in0[i] += wet * (tmp0[i] * width + tmp1[i] * width1);
+					in1[i] += wet * (tmp1[i] * width + tmp0[i] * width1);
+				}
 			}
 
-			*in0++ += wet * out0;
-			*in1++ += wet * out1;
+			in0 += nblock;
+			in1 += nblock;
+			nframes -= nblock;
 		}
+
+		return false;
 	}
 
 protected:
@@ -136,21 +172,35 @@ protected:
 	static const uint32_t NUM_ALLPASSES = 6;
 	static const uint32_t STEREO_SPREAD = 23;
 
+	// combs as SIMD lanes, padded to a multiple of 4.
+	static const uint32_t NUM_LANES     = 12;
+	static const uint32_t BLOCK_SIZE    = 64;
+
+	// tail length estimate (-100dB), longest comb plus allpasses.
+	uint32_t tail() const
+	{
+		const float sr = m_srate / 44100.0f;
+		const float ncomb = float(1748 + STEREO_SPREAD) * sr;
+		const float nallpass = float(556 + 441 + 341 + 225 + 180 + 153
+			+ NUM_ALLPASSES * STEREO_SPREAD) * sr;
+		const float room = (m_room < 0.9999f ? m_room : 0.9999f);
+		float nrepeats = 0.0f;
+		if (room > 1E-5f)
+			nrepeats = ::logf(1E-5f) / ::logf(room);
+		return uint32_t(ncomb * (1.0f + nrepeats) + 4.0f * nallpass);
+	}
+
 	void reset_room()
 	{
-		for (uint32_t j = 0; j < NUM_COMBS; ++j) {
-			m_comb0[j].set_feedb(m_room);
-			m_comb1[j].set_feedb(m_room);
-		}
+		m_combs0.set_feedb(m_room);
+		m_combs1.set_feedb(m_room);
 	}
 
 	void reset_damp()
 	{
 		const float damp2 = m_damp * m_damp;
-		for (uint32_t j = 0; j < NUM_COMBS; ++j) {
-			m_comb0[j].set_damp(damp2);
-			m_comb1[j].set_damp(damp2);
-		}
+		m_combs0.set_damp(damp2);
+		m_combs1.set_damp(damp2);
 	}
 
 	void reset_feedb()
@@ -195,6 +245,9 @@ protected:
 			}
 		}
 
+		uint32_t size() const
+			{ return m_size; }
+
 		float *tick()
 		{
 			float *buf = m_buffer + m_index;
@@ -203,19 +256,62 @@ protected:
 			return buf;
 		}
 
-	private:
+		// block read (strided), nframes <= size.
+		void read(float *out, uint32_t nframes, uint32_t stride) const
+		{
+			uint32_t index = m_index;
+			while (nframes > 0) {
+				uint32_t nread = m_size - index;
+				if (nread > nframes)
+					nread = nframes;
+				const float *buf = m_buffer + index;
+				for (uint32_t i = 0; i < nread; ++i, out += stride)
+					*out = buf[i];
+				index += nread;
+				if (index >= m_size)
+					index = 0;
+				nframes -= nread;
+			}
+		}
+
+		// block write-back (strided), nframes <= size.
+		void write(const float *in, uint32_t nframes, uint32_t stride)
+		{
+			while (nframes > 0) {
+				uint32_t nread = m_size - m_index;
+				if (nread > nframes)
+					nread = nframes;
+				float *buf = m_buffer + m_index;
+				for (uint32_t i = 0; i < nread; ++i, in += stride)
+					buf[i] = *in;
+				m_index += nread;
+				if (m_index >= m_size)
+					m_index = 0;
+				nframes -= nread;
+			}
+		}
+
+	protected:
 
 		float   *m_buffer;
 		uint32_t m_size;
 		uint32_t m_index;
 	};
 
-	class comb_filter : public sample_buffer
+	// parallel comb filters bank
+	class comb_bank
 	{
 	public:
 
-		comb_filter (uint32_t size = 0)
-			: sample_buffer(size), m_feedb(0.5f), m_damp(0.5f), m_out(0.0f) {}
+		comb_bank() : m_feedb(0.5f), m_damp(0.5f)
+		{
+			::memset(m_x, 0, sizeof(m_x));
+			::memset(m_y, 0, sizeof(m_y));
+			::memset(m_out, 0, sizeof(m_out));
+		}
+
+		void resize(uint32_t j, uint32_t size)
+			{ m_combs[j].resize(size); }
 
 		void set_feedb(float feedb)
 			{ m_feedb = feedb; }
@@ -228,22 +324,69 @@ protected:
 			{ return m_damp; }
 
 		void reset()
-			{ sample_buffer::reset(); m_out = 0.0f; }
+		{
+			for (uint32_t j = 0; j < NUM_COMBS; ++j)
+				m_combs[j].reset();
 
-		float output(float in)
+			::memset(m_out, 0, sizeof(m_out));
+		}
+
+		// sum of all comb outputs; nframes <= shortest comb size.
+		void process(const float *in, float *out, uint32_t nframes)
 		{
-			float *buf = tick();
-			float  out = *buf;
-			m_out = denormal(out * (1.0f - m_damp) + m_out * m_damp);
-			*buf = in + (m_out * m_feedb);
-			return out;
+			uint32_t i, j;
+
+			// gather delayed samples, lane-interleaved...
+			for (j = 0; j < NUM_COMBS; ++j)
+				m_combs[j].read(&m_x[0][j], nframes, NUM_LANES);
+
+			// lowpass-feedback recursion, all lanes at once...
+			alignas(16) float y0[NUM_LANES];
+			for (j = 0; j < NUM_LANES; ++j)
+				y0[j] = m_out[j];
+			const float feedb = m_feedb;
+			const float damp  = m_damp;
+			const float damp1 = 1.0f - damp;
+			for (i = 0; i < nframes; ++i) {
+				const float *x = m_x[i];
+				float *y = m_y[i];
+				const float in0 = in[i];
+			#if defined(__GNUC__) && !defined(__clang__)
+				#pragma GCC unroll 1 // keep it a vector loop (no scalar SLP)
+			#endif
+				for (j = 0; j < NUM_LANES; ++j) {
+					y0[j] = denormal_lane(x[j] * damp1 + y0[j] * damp);
+					y[j] = in0 + (y0[j] * feedb);
+				}
+			}
+			for (j = 0; j < NUM_LANES; ++j)
+				m_out[j] = y0[j];
+
+			// write-back feedback samples...
+			for (j = 0; j < NUM_COMBS; ++j)
+				m_combs[j].write(&m_y[0][j], nframes, NUM_LANES);
+
+			// mix-down (same summation order as per-frame combs)
+			for (i = 0; i < nframes; ++i) {
+				const float *x = m_x[i];
+				float sum = 0.0f;
+				for (j = 0; j < NUM_COMBS; ++j)
+					sum += x[j];
+				out[i] = sum;
+			}
 		}
 
 	private:
 
+		sample_buffer m_combs[NUM_COMBS];
+
 		float m_feedb;
 		float m_damp;
-		float m_out;
+
+		alignas(16) float m_x[BLOCK_SIZE][NUM_LANES];
+		alignas(16) float m_y[BLOCK_SIZE][NUM_LANES];
+
+		alignas(16) float m_out[NUM_LANES];
 	};
 
 	class allpass_filter : public sample_buffer
@@ -266,6 +409,28 @@ protected:
 			return out - in;
 		}
 
+		// process block in-place, split at wrap-around.
+		void process(float *inout, uint32_t nframes)
+		{
+			while (nframes > 0) {
+				uint32_t nread = m_size - m_index;
+				if (nread > nframes)
+					nread = nframes;
+				float *buf = m_buffer + m_index;
+				for (uint32_t i = 0; i < nread; ++i) {
+					const float in  = inout[i];
+					const float out = buf[i];
+					buf[i] = denormal(in + out * m_feedb);
+					inout[i] = out - in;
+				}
+				m_index += nread;
+				if (m_index >= m_size)
+					m_index = 0;
+				inout += nread;
+				nframes -= nread;
+			}
+		}
+
 	private:
 
 		float m_feedb;
@@ -278,6 +443,10 @@ protected:
 		return (u.w & 0x7f800000) ? v : 0.0f;
 	}
 
+	// same as above, select-only (vectorizable) form.
+	static float denormal_lane(float v)
+		{ return (::fabsf(v) < 1.17549435E-38f ? 0.0f : v); }
+
 private:
 
 	float m_srate;
@@ -286,8 +455,12 @@ private:
 	float m_damp;
 	float m_feedb;
 
-	comb_filter m_comb0[NUM_COMBS];
-	comb_filter m_comb1[NUM_COMBS];
+	uint32_t m_nblock;
+
+	uint32_t m_tail;
+
+	comb_bank m_combs0;
+	comb_bank m_combs1;
 
 	allpass_filter m_allpass0[NUM_ALLPASSES];
 	allpass_filter m_allpass1[NUM_ALLPASSES];
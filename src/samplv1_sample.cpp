@@ -68,7 +68,8 @@ samplv1_sample::~samplv1_sample (void)
 
 
 // init.
-bool samplv1_sample::open ( const char *filename, float freq0, uint16_t otabs )
+bool samplv1_sample::open ( const char *filename, float freq0, uint16_t otabs,
+	const samplv1_sample_cancel *cancel, uint32_t ticket )
 {
 	if (filename == nullptr)
 		return false;
@@ -100,7 +101,25 @@ bool samplv1_sample::open ( const char *filename, float freq0, uint16_t otabs )
 
 	float *buffer = new float [m_nchannels * m_nframes];
 
-	const int nread = ::sf_readf_float(file, buffer, m_nframes);
+	// read in blocks, bailing out when superseded...
+	const sf_count_t NREAD = 65536;
+	sf_count_t nread = 0;
+	while (nread < sf_count_t(m_nframes)) {
+		if (cancel && cancel->cancelled(ticket)) {
+			delete [] buffer;
+			::sf_close(file);
+			close();
+			return false;
+		}
+		sf_count_t nblock = sf_count_t(m_nframes) - nread;
+		if (nblock > NREAD)
+			nblock = NREAD;
+		nblock = ::sf_readf_float(file, buffer + nread * m_nchannels, nblock);
+		if (nblock <= 0)
+			break;
+		nread += nblock;
+	}
+
 	if (nread > 0) {
 		// resample start...
 		const uint32_t ninp = uint32_t(nread);
@@ -137,6 +156,8 @@ bool samplv1_sample::open ( const char *filename, float freq0, uint16_t otabs )
 	const uint16_t ntabs = (m_ntabs + 1);
 	const uint32_t nsize = (m_nframes + 4);
 	m_pframes = new float ** [ntabs];
+	for (uint16_t itab = 0; itab < ntabs; ++itab)
+		m_pframes[itab] = nullptr;
 
 	m_offset_phase0 = new float [ntabs];
 	m_loop_phase1 = new float [ntabs];
@@ -147,6 +168,15 @@ bool samplv1_sample::open ( const char *filename, float freq0, uint16_t otabs )
 		pshifter = samplv1_pshifter::create(m_nchannels, m_srate);
 
 	for (uint16_t itab = 0; itab < ntabs; ++itab) {
+		// bail out when superseded (octave-table boundary)...
+		if (cancel && cancel->cancelled(ticket)) {
+			if (pshifter)
+				samplv1_pshifter::destroy(pshifter);
+			delete [] buffer;
+			::sf_close(file);
+			close();
+			return false;
+		}
 		float **pframes = new float * [m_nchannels];
 		for (uint16_t k = 0; k < m_nchannels; ++k) {
 			pframes[k] = new float [nsize];
@@ -206,6 +236,8 @@ void samplv1_sample::close (void)
 		const uint16_t ntabs = m_ntabs + 1;
 		for (uint16_t itab = 0; itab < ntabs; ++itab) {
 			float **pframes = m_pframes[itab];
+			if (pframes == nullptr)
+				continue;
 			for (uint16_t k = 0; k < m_nchannels; ++k)
 				delete [] pframes[k];
 			delete [] pframes;
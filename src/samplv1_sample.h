@@ -29,11 +29,38 @@
 
 #include <cmath>
 
+#include <atomic>
+
 
 // forward decls.
 class samplv1;
 
 
+//-------------------------------------------------------------------------
+// samplv1_sample_cancel - superseded sample load cancellation.
+//
+
+class samplv1_sample_cancel
+{
+public:
+
+	// ctor.
+	samplv1_sample_cancel() : m_serial(0) {}
+
+	// a newer load request (any thread); returns its ticket.
+	uint32_t request()
+		{ return m_serial.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+	// whether a ticket has been superseded.
+	bool cancelled(uint32_t ticket) const
+		{ return m_serial.load(std::memory_order_acquire) != ticket; }
+
+private:
+
+	std::atomic<uint32_t> m_serial;
+};
+
+
 //-------------------------------------------------------------------------
 // samplv1_sample - sampler wave table.
 //
@@ -134,8 +161,9 @@ public:
 	bool isLoopEndRelease() const
 		{ return m_loop_end_release; }
 
-	// init.
-	bool open(const char *filename, float freq0 = 1.0f, uint16_t otabs = 0);
+	// init (cancellable, at block boundaries).
+	bool open(const char *filename, float freq0 = 1.0f, uint16_t otabs = 0,
+		const samplv1_sample_cancel *cancel = nullptr, uint32_t ticket = 0);
 	void close();
 
 	// accessors.
@@ -20,6 +20,7 @@
 *****************************************************************************/
 
 #include "samplv1_sched.h"
+#include "samplv1_sem.h"
 
 #include <QThread>
 #include <QMutex>
@@ -27,178 +28,818 @@
 
 #include <QHash>
 
+#include <chrono>
+
+
+// forward decls.
+class samplv1_sched_pool;
+class samplv1_sched_excl;
+
 
 //-------------------------------------------------------------------------
-// samplv1_sched_thread - worker/schedule thread decl.
+// samplv1_sched_lane - per-instance schedule queue (lane) decl.
+//
+// Each instance has two lanes: a fast one, for cheap UI-feedback jobs
+// (Controller, MidiIn, Controls), and a slow one, for everything else
+// (Sample, Programs, Effects). Jobs of the same lane are processed in
+// order; lanes take turns on the pool, one job each (round-robin), fast
+// lanes always first. Lanes only order dispatch though: no two jobs of
+// the same instance ever run at once, whatever their lane (see below).
 //
 
-class samplv1_sched_thread : public QThread
+class samplv1_sched_lane
 {
 public:
 
+	// lane priorities.
+	enum Lane { Fast = 0, Slow = 1, NumLanes = 2 };
+
 	// ctor.
-	samplv1_sched_thread(uint32_t nsize = 32);
+	samplv1_sched_lane(Lane lane, samplv1_sched_excl *excl, uint32_t nsize = 32);
 
 	// dtor.
-	~samplv1_sched_thread();
+	~samplv1_sched_lane();
+
+	// lane priority accessor.
+	Lane lane() const
+		{ return m_lane; }
+
+	// lane priority of a sched type.
+	static Lane lane(samplv1_sched::Type stype);
 
-	// schedule processing and wake from wait condition.
+	// schedule processing (any thread).
 	void schedule(samplv1_sched *sched);
 
+	// process one pending run; what to do next.
+	enum Next { None, Again, Delete };
+
+	Next process_one();
+
 	// process all pending runs immediately.
 	void sync_pending();
 
 	// clear all pending runs immediately.
 	void sync_reset();
 
+	// clear pending runs of a sched that's gone.
+	void cancel(samplv1_sched *sched);
+
+	// release (last sched gone).
+	void close();
+
+private:
+
+	// lane priority.
+	Lane m_lane;
+
+	// sync queue item (timestamped).
+	struct Item
+	{
+		samplv1_sched *sched;
+		uint64_t stamp;
+	};
+
+	// process one item.
+	void process(const Item& item);
+
+	// sync queue instance reference.
+	samplv1_sched_queue<Item> m_items;
+
+	// whether this lane is on the ready queue.
+	std::atomic<bool> m_ready;
+
+	// whether this lane is gone.
+	bool m_closed;
+
+	// serializes processing (worker or immediate).
+	QMutex m_mutex;
+
+	// per-instance processing exclusion (shared).
+	samplv1_sched_excl *m_excl;
+
+	// overflow ready list link (pool).
+	samplv1_sched_lane *m_overflow_next;
+
+	friend class samplv1_sched_pool;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_excl - per-instance processing exclusion decl.
+//
+// Shared by the lanes of an instance, so that their jobs never run
+// concurrently (eg. Controls parameter updates amidst a Programs preset
+// load). Workers never block on it: a lane that finds it busy is just
+// parked, to be put back on the ready queue when it gets released.
+//
+
+class samplv1_sched_excl
+{
+public:
+
+	// ctor.
+	samplv1_sched_excl();
+
+	// reference counting (one per lane).
+	void ref();
+	bool unref();
+
+	// worker acquire; otherwise park the lane (still marked ready).
+	bool acquire(samplv1_sched_lane *lane);
+
+	// immediate acquire (non-worker); wait for it.
+	void acquire_wait();
+
+	// release; parked lanes go back to the ready queue.
+	void release();
+
+private:
+
+	// instance variables.
+	std::atomic<uint32_t> m_refcount;
+
+	QMutex m_mutex;
+	QWaitCondition m_cond;
+
+	bool m_busy;
+
+	samplv1_sched_lane *m_parked[samplv1_sched_lane::NumLanes];
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_thread - worker/schedule thread decl.
+//
+
+class samplv1_sched_thread : public QThread
+{
+public:
+
+	// ctor.
+	samplv1_sched_thread(samplv1_sched_pool *pool, bool fast);
+
 protected:
 
 	// main thread executive.
 	void run();
-	void run_process();
 
-	// clear all.
-	void clear();
+private:
+
+	// instance variables.
+	samplv1_sched_pool *m_pool;
+
+	// whether reserved for the fast lanes.
+	bool m_fast;
+};
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_pool - worker/schedule thread pool decl.
+//
+
+class samplv1_sched_pool
+{
+public:
+
+	// ctor.
+	samplv1_sched_pool(uint32_t nsize = 64);
+
+	// dtor.
+	~samplv1_sched_pool();
+
+	// put lane on its ready queue and wake a worker.
+	void ready(samplv1_sched_lane *lane);
+
+	// worker executive (one job per wake-up).
+	bool process(bool fast);
+
+protected:
+
+	// overflow ready list push (any thread; never fails).
+	void push_overflow(samplv1_sched_lane *lane);
+
+	// next ready lane of some priority, overflowed ones first.
+	bool pop_ready(samplv1_sched_lane::Lane l, samplv1_sched_lane *& lane);
 
 private:
 
-	// sync queue instance reference.
-	uint32_t m_nsize;
-	uint32_t m_nmask;
+	// instance variables.
+	samplv1_sched_queue<samplv1_sched_lane *> m_ready_fast;
+	samplv1_sched_queue<samplv1_sched_lane *> m_ready_slow;
 
-	samplv1_sched **m_items;
+	// overflow ready lists, per lane priority: lock-free pushed
+	// (LIFO), then popped in order (FIFO), one worker at a time.
+	struct Overflow
+	{
+		std::atomic<samplv1_sched_lane *> head;
+		samplv1_sched_lane *list;
+		std::atomic<int32_t> count;
+	};
 
-	volatile uint32_t m_iread;
-	volatile uint32_t m_iwrite;
+	Overflow m_overflow[samplv1_sched_lane::NumLanes];
 
-	// whether the thread is logically running.
-	volatile bool m_running;
+	QMutex m_overflow_mutex;
 
-	// thread synchronization objects.
-	QMutex m_mutex;
-	QWaitCondition m_cond;
+	QList<samplv1_sched_thread *> m_threads;
+
+	// whether the threads are logically running.
+	std::atomic<bool> m_running;
+
+	// thread synchronization objects (real-time safe post):
+	// any worker (all lanes) and fast-only (reserved) worker.
+	samplv1_sem m_sem;
+	samplv1_sem m_sem_fast;
 };
 
 
-static samplv1_sched_thread *g_sched_thread = nullptr;
+static samplv1_sched_pool *g_sched_pool = nullptr;
 static uint32_t g_sched_refcount = 0;
 
-static QHash<samplv1 *, QList<samplv1_sched::Notifier *> > g_sched_notifiers;
+// per-instance lanes.
+struct samplv1_sched_instance
+{
+	uint32_t refcount;
+
+	samplv1_sched_lane *lanes[samplv1_sched_lane::NumLanes];
+};
+
+static QMutex g_sched_mutex;
+static QHash<samplv1 *, samplv1_sched_instance *> g_sched_instances;
 
 
 //-------------------------------------------------------------------------
-// samplv1_sched_thread - worker/schedule thread impl.
+// samplv1_sched_notifiers - notifier registry snapshot.
+//
+// Immutable once published; writers replace it as a whole and wait
+// for any readers still on the old one (RCU-like grace period).
 //
 
-// ctor.
-samplv1_sched_thread::samplv1_sched_thread ( uint32_t nsize ) : QThread()
+struct samplv1_sched_notifiers
 {
-	m_nsize = (4 << 1);
-	while (m_nsize < nsize)
-		m_nsize <<= 1;
-	m_nmask = (m_nsize - 1);
-	m_items = new samplv1_sched * [m_nsize];
+	struct Item
+	{
+		samplv1 *pSampl;
+		QList<samplv1_sched::Notifier *> list;
+	};
 
-	m_iread  = 0;
-	m_iwrite = 0;
+	QList<Item> items;
+};
 
-	::memset(m_items, 0, m_nsize * sizeof(samplv1_sched *));
 
-	m_running = false;
+static std::atomic<samplv1_sched_notifiers *> g_sched_notifiers(nullptr);
+
+// readers, counted per epoch parity: new readers always enter on
+// the current one, so a grace period only waits for the ones that
+// were there before, never for a steady stream of new readers.
+static std::atomic<uint32_t> g_sched_notifiers_epoch(0);
+static std::atomic<uint32_t> g_sched_notifiers_readers[2];
+
+// whether the current thread is broadcasting (nesting depth).
+static thread_local uint32_t g_sched_notifiers_depth = 0;
+
+// snapshots replaced from within a broadcast, freed later.
+static QList<samplv1_sched_notifiers *> g_sched_notifiers_retired;
+
+static QMutex g_sched_notifiers_mutex;
+static QMutex g_sched_notifiers_sync_mutex;
+
+
+// notifier registry reader enter/leave; returns epoch parity.
+static uint32_t samplv1_sched_notifiers_enter (void)
+{
+	for (;;) {
+		const uint32_t e = (g_sched_notifiers_epoch.load() & 1);
+		++g_sched_notifiers_readers[e];
+		// still the current one? (otherwise, a writer flipped in-between)
+		if ((g_sched_notifiers_epoch.load() & 1) == e)
+			return e;
+		--g_sched_notifiers_readers[e];
+	}
+}
+
+static void samplv1_sched_notifiers_leave ( uint32_t e )
+{
+	--g_sched_notifiers_readers[e];
 }
 
 
-// dtor.
-samplv1_sched_thread::~samplv1_sched_thread (void)
-{
-	// fake sync and wait
-	if (m_running && isRunning()) do {
-		if (m_mutex.tryLock()) {
-			m_running = false;
-			m_cond.wakeAll();
-			m_mutex.unlock();
+// notifier registry grace period: wait for readers that may still be
+// on any snapshot unpublished before; one writer at a time.
+static void samplv1_sched_notifiers_sync (void)
+{
+	QMutexLocker locker(&g_sched_notifiers_sync_mutex);
+
+	const uint32_t e = (g_sched_notifiers_epoch.fetch_add(1) & 1);
+	while (g_sched_notifiers_readers[e].load() > 0)
+		QThread::yieldCurrentThread();
+}
+
+
+// notifier registry update (non-real-time).
+//
+// Re-entrant calls (ie. attach/detach from within a notify()) can't
+// wait for the grace period, as they are readers themselves: the old
+// snapshot is then retired, to be freed by the next regular update.
+// Note that a notifier detached that way may still get notified, by
+// any broadcast already in flight on another thread.
+//
+static void samplv1_sched_notifiers_update (
+	samplv1 *pSampl, samplv1_sched::Notifier *pNotifier, bool bAdd )
+{
+	QList<samplv1_sched_notifiers *> old_list;
+
+	g_sched_notifiers_mutex.lock();
+
+	samplv1_sched_notifiers *old_notifiers = g_sched_notifiers.load();
+	samplv1_sched_notifiers *new_notifiers = new samplv1_sched_notifiers();
+
+	bool bFound = false;
+	if (old_notifiers) {
+		QListIterator<samplv1_sched_notifiers::Item> iter(old_notifiers->items);
+		while (iter.hasNext()) {
+			samplv1_sched_notifiers::Item item = iter.next();
+			if (item.pSampl == pSampl) {
+				item.list.removeAll(pNotifier);
+				if (bAdd)
+					item.list.append(pNotifier);
+				bFound = true;
+			}
+			if (!item.list.isEmpty())
+				new_notifiers->items.append(item);
 		}
-	} while (!wait(100));
+	}
+
+	if (bAdd && !bFound) {
+		samplv1_sched_notifiers::Item item;
+		item.pSampl = pSampl;
+		item.list.append(pNotifier);
+		new_notifiers->items.append(item);
+	}
+
+	if (new_notifiers->items.isEmpty()) {
+		delete new_notifiers;
+		new_notifiers = nullptr;
+	}
+
+	// publish...
+	g_sched_notifiers.store(new_notifiers);
+
+	if (old_notifiers)
+		g_sched_notifiers_retired.append(old_notifiers);
+
+	// re-entrant: no waiting, no freeing.
+	if (g_sched_notifiers_depth > 0) {
+		g_sched_notifiers_mutex.unlock();
+		return;
+	}
+
+	old_list.swap(g_sched_notifiers_retired);
 
-	delete [] m_items;
+	g_sched_notifiers_mutex.unlock();
+
+	// grace period: wait for readers on the old ones (unlocked,
+	// so that any re-entrant update meanwhile won't deadlock.)
+	if (!old_list.isEmpty())
+		samplv1_sched_notifiers_sync();
+
+	QListIterator<samplv1_sched_notifiers *> iter(old_list);
+	while (iter.hasNext())
+		delete iter.next();
+}
+
+
+// queue statistics.
+static std::atomic<uint32_t> g_sched_overflows(0);
+static std::atomic<uint64_t> g_sched_latency_max(0);
+static std::atomic<uint64_t> g_sched_latency_sum(0);
+static std::atomic<uint32_t> g_sched_latency_count(0);
+
+static std::atomic<uint32_t> g_sched_latency_histogram
+	[samplv1_sched::NUM_TYPES][samplv1_sched::HISTOGRAM_SIZE];
+
+static std::atomic<uint32_t> g_sched_deadline_misses(0);
+
+
+// monotonic timestamp (nanosecs).
+static inline uint64_t samplv1_sched_stamp (void)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds> (
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_lane - per-instance schedule queue (lane) impl.
+//
+
+// ctor.
+samplv1_sched_lane::samplv1_sched_lane (
+	Lane lane, samplv1_sched_excl *excl, uint32_t nsize )
+	: m_lane(lane), m_items(nsize), m_ready(false), m_closed(false),
+		m_excl(excl), m_overflow_next(nullptr)
+{
+	m_excl->ref();
+}
+
+
+// dtor.
+samplv1_sched_lane::~samplv1_sched_lane (void)
+{
+	if (m_excl->unref())
+		delete m_excl;
 }
 
 
-// schedule processing and wake from wait condition.
-void samplv1_sched_thread::schedule ( samplv1_sched *sched )
+// lane priority of a sched type.
+samplv1_sched_lane::Lane samplv1_sched_lane::lane ( samplv1_sched::Type stype )
+{
+	switch (stype) {
+	case samplv1_sched::Controller:
+	case samplv1_sched::MidiIn:
+	case samplv1_sched::Controls:
+		return Fast;
+	default:
+		return Slow;
+	}
+}
+
+
+// schedule processing (any thread).
+void samplv1_sched_lane::schedule ( samplv1_sched *sched )
 {
 	if (!sched->sync_wait()) {
-		const uint32_t w = (m_iwrite + 1) & m_nmask;
-		if (w != m_iread) {
-			m_items[m_iwrite] = sched;
-			m_iwrite = w;
+		const Item item = { sched, samplv1_sched_stamp() };
+		if (!m_items.push(item)) {
+			// queue full: let it be re-scheduled later.
+			sched->sync_done();
+			++g_sched_overflows;
 		}
 	}
 
-	if (m_mutex.tryLock()) {
-		m_cond.wakeAll();
-		m_mutex.unlock();
+	if (!m_ready.exchange(true, std::memory_order_acq_rel)) {
+		if (g_sched_pool)
+			g_sched_pool->ready(this);
+		else // not queued: let the next schedule try again.
+			m_ready.store(false, std::memory_order_release);
 	}
 }
 
 
+// process one pending run; what to do next.
+samplv1_sched_lane::Next samplv1_sched_lane::process_one (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_closed)
+		return Delete;
+
+	// other lane busy on this instance: parked.
+	if (!m_excl->acquire(this))
+		return None;
+
+	m_ready.exchange(false, std::memory_order_acq_rel);
+
+	Item item;
+	if (m_items.pop(item))
+		process(item);
+
+	m_excl->release();
+
+	// more to come: back of the line.
+	if (!m_items.empty() && !m_ready.exchange(true, std::memory_order_acq_rel))
+		return Again;
+
+	return None;
+}
+
+
 // process all pending runs, immediately.
-void samplv1_sched_thread::sync_pending (void)
+void samplv1_sched_lane::sync_pending (void)
 {
 	QMutexLocker locker(&m_mutex);
 
-	run_process();
+	m_excl->acquire_wait();
+
+	Item item;
+	while (m_items.pop(item))
+		process(item);
+
+	m_excl->release();
 }
 
 
 // clear all pending runs, immediately.
-void samplv1_sched_thread::sync_reset (void)
+void samplv1_sched_lane::sync_reset (void)
 {
 	QMutexLocker locker(&m_mutex);
 
-	clear();
+	Item item;
+	while (m_items.pop(item))
+		item.sched->sync_done();
 }
 
 
-void samplv1_sched_thread::clear (void)
+// clear pending runs of a sched that's gone.
+void samplv1_sched_lane::cancel ( samplv1_sched *sched )
 {
-	m_iread  = 0;
-	m_iwrite = 0;
+	QMutexLocker locker(&m_mutex);
 
-	::memset(m_items, 0, m_nsize * sizeof(samplv1_sched *));
+	uint32_t n = 0;
+	Item item;
+	while (n++ < m_items.size() && m_items.pop(item)) {
+		if (item.sched != sched)
+			m_items.push(item);
+	}
 }
 
 
-// main thread executive.
-void samplv1_sched_thread::run (void)
+// release (last sched gone): deletes itself, now or
+// later by the worker that still has it on the ready queue.
+void samplv1_sched_lane::close (void)
 {
 	m_mutex.lock();
+	m_closed = true;
+	Item item;
+	while (m_items.pop(item))
+		item.sched->sync_done();
+	const bool ready = m_ready.exchange(true, std::memory_order_acq_rel);
+	m_mutex.unlock();
 
-	m_running = true;
+	if (!ready)
+		delete this;
+}
 
-	while (m_running) {
-		// do whatever we must...
-		run_process();
-		// wait for sync...
-		m_cond.wait(&m_mutex);
+
+// process one item.
+void samplv1_sched_lane::process ( const Item& item )
+{
+	const uint64_t latency = samplv1_sched_stamp() - item.stamp;
+	uint64_t latency_max = g_sched_latency_max.load();
+	while (latency > latency_max
+		&& !g_sched_latency_max.compare_exchange_weak(latency_max, latency))
+		;
+	g_sched_latency_sum += latency;
+	++g_sched_latency_count;
+
+	// per-type histogram: [0] < 1us, [i] < 2^i us.
+	uint64_t usecs = latency / 1000;
+	uint32_t i = 0;
+	while (usecs > 0 && i < samplv1_sched::HISTOGRAM_SIZE - 1) {
+		usecs >>= 1;
+		++i;
+	}
+	++g_sched_latency_histogram[item.sched->stype()][i];
+
+	item.sched->sync_process();
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_excl - per-instance processing exclusion impl.
+//
+
+// ctor.
+samplv1_sched_excl::samplv1_sched_excl (void)
+	: m_refcount(0), m_busy(false)
+{
+	for (int l = 0; l < samplv1_sched_lane::NumLanes; ++l)
+		m_parked[l] = nullptr;
+}
+
+
+// reference counting (one per lane).
+void samplv1_sched_excl::ref (void)
+{
+	++m_refcount;
+}
+
+bool samplv1_sched_excl::unref (void)
+{
+	return (--m_refcount == 0);
+}
+
+
+// worker acquire; otherwise park the lane (still marked ready).
+bool samplv1_sched_excl::acquire ( samplv1_sched_lane *lane )
+{
+	QMutexLocker locker(&m_mutex);
+
+	if (m_busy) {
+		m_parked[lane->lane()] = lane;
+		return false;
 	}
 
+	m_busy = true;
+	return true;
+}
+
+
+// immediate acquire (non-worker); wait for it.
+void samplv1_sched_excl::acquire_wait (void)
+{
+	QMutexLocker locker(&m_mutex);
+
+	while (m_busy)
+		m_cond.wait(&m_mutex);
+
+	m_busy = true;
+}
+
+
+// release; parked lanes go back to the ready queue.
+void samplv1_sched_excl::release (void)
+{
+	samplv1_sched_lane *parked[samplv1_sched_lane::NumLanes];
+
+	m_mutex.lock();
+	m_busy = false;
+	for (int l = 0; l < samplv1_sched_lane::NumLanes; ++l) {
+		parked[l] = m_parked[l];
+		m_parked[l] = nullptr;
+	}
+	m_cond.wakeAll();
 	m_mutex.unlock();
+
+	for (int l = 0; l < samplv1_sched_lane::NumLanes; ++l) {
+		if (parked[l] && g_sched_pool)
+			g_sched_pool->ready(parked[l]);
+	}
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_thread - worker/schedule thread impl.
+//
+
+// ctor.
+samplv1_sched_thread::samplv1_sched_thread ( samplv1_sched_pool *pool, bool fast )
+	: QThread(), m_pool(pool), m_fast(fast)
+{
+}
+
+
+// main thread executive.
+void samplv1_sched_thread::run (void)
+{
+	while (m_pool->process(m_fast))
+		;
+}
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_pool - worker/schedule thread pool impl.
+//
+
+// ctor.
+samplv1_sched_pool::samplv1_sched_pool ( uint32_t nsize )
+	: m_ready_fast(nsize), m_ready_slow(nsize), m_running(true)
+{
+	for (int l = 0; l < samplv1_sched_lane::NumLanes; ++l) {
+		m_overflow[l].head = nullptr;
+		m_overflow[l].list = nullptr;
+		m_overflow[l].count = 0;
+	}
+
+	int nthreads = QThread::idealThreadCount() >> 1;
+	if (nthreads < 2)
+		nthreads = 2;
+	else
+	if (nthreads > 4)
+		nthreads = 4;
+
+	// first one is reserved for the fast lanes.
+	for (int i = 0; i < nthreads; ++i) {
+		samplv1_sched_thread *thread = new samplv1_sched_thread(this, i == 0);
+		thread->start();
+		m_threads.append(thread);
+	}
+}
+
+
+// dtor.
+samplv1_sched_pool::~samplv1_sched_pool (void)
+{
+	// stop and wait
+	m_running = false;
+	m_sem.post(m_threads.count());
+	m_sem_fast.post(m_threads.count());
+
+	QListIterator<samplv1_sched_thread *> iter(m_threads);
+	while (iter.hasNext()) {
+		samplv1_sched_thread *thread = iter.next();
+		thread->wait();
+		delete thread;
+	}
+
+	m_threads.clear();
+
+	// left-over (closed) lanes.
+	samplv1_sched_lane *lane = nullptr;
+	while (pop_ready(samplv1_sched_lane::Fast, lane)
+		|| pop_ready(samplv1_sched_lane::Slow, lane)) {
+		if (lane->process_one() == samplv1_sched_lane::Delete)
+			delete lane;
+	}
 }
 
 
-void samplv1_sched_thread::run_process (void)
+// put lane on its ready queue and wake a worker.
+void samplv1_sched_pool::ready ( samplv1_sched_lane *lane )
 {
-	uint32_t r = m_iread;
-	while (r != m_iwrite) {
-		samplv1_sched *sched = m_items[r];
-		if (sched) {
-			sched->sync_process();
-			m_items[r] = nullptr;
+	if (lane->lane() == samplv1_sched_lane::Fast) {
+		if (!m_ready_fast.push(lane))
+			push_overflow(lane);
+		// whichever comes first...
+		m_sem_fast.post();
+		m_sem.post();
+	} else {
+		if (!m_ready_slow.push(lane))
+			push_overflow(lane);
+		m_sem.post();
+	}
+}
+
+
+// overflow ready list push (any thread; never fails).
+void samplv1_sched_pool::push_overflow ( samplv1_sched_lane *lane )
+{
+	++g_sched_overflows;
+
+	Overflow& overflow = m_overflow[lane->lane()];
+
+	// count first, so that it never falls short.
+	++overflow.count;
+
+	samplv1_sched_lane *head = overflow.head.load(std::memory_order_relaxed);
+	do lane->m_overflow_next = head;
+	while (!overflow.head.compare_exchange_weak(head, lane,
+		std::memory_order_release, std::memory_order_relaxed));
+}
+
+
+// next ready lane of some priority, overflowed ones first.
+bool samplv1_sched_pool::pop_ready (
+	samplv1_sched_lane::Lane l, samplv1_sched_lane *& lane )
+{
+	Overflow& overflow = m_overflow[l];
+	if (overflow.count.load(std::memory_order_acquire) > 0) {
+		QMutexLocker locker(&m_overflow_mutex);
+		if (overflow.list == nullptr) {
+			// take all pushed so far, oldest first.
+			samplv1_sched_lane *head
+				= overflow.head.exchange(nullptr, std::memory_order_acquire);
+			while (head) {
+				samplv1_sched_lane *next = head->m_overflow_next;
+				head->m_overflow_next = overflow.list;
+				overflow.list = head;
+				head = next;
+			}
 		}
-		r = (r + 1) & m_nmask;
+		if (overflow.list) {
+			lane = overflow.list;
+			overflow.list = lane->m_overflow_next;
+			lane->m_overflow_next = nullptr;
+			--overflow.count;
+			return true;
+		}
+	}
+
+	if (l == samplv1_sched_lane::Fast)
+		return m_ready_fast.pop(lane);
+	else
+		return m_ready_slow.pop(lane);
+}
+
+
+// worker executive (one job per wake-up).
+bool samplv1_sched_pool::process ( bool fast )
+{
+	if (fast)
+		m_sem_fast.wait();
+	else
+		m_sem.wait();
+
+	if (!m_running)
+		return false;
+
+	// fast lanes first, always.
+	samplv1_sched_lane *lane = nullptr;
+	if (!pop_ready(samplv1_sched_lane::Fast, lane)
+		&& (fast || !pop_ready(samplv1_sched_lane::Slow, lane)))
+		return true;
+
+	switch (lane->process_one()) {
+	case samplv1_sched_lane::Again:
+		ready(lane);
+		break;
+	case samplv1_sched_lane::Delete:
+		delete lane;
+		break;
+	default:
+		break;
 	}
-	m_iread = r;
+
+	return true;
 }
 
 
@@ -208,35 +849,55 @@ void samplv1_sched_thread::run_process (void)
 
 // ctor.
 samplv1_sched::samplv1_sched ( samplv1 *pSampl, Type stype, uint32_t nsize )
-	: m_pSampl(pSampl), m_stype(stype), m_sync_wait(false)
+	: m_pSampl(pSampl), m_stype(stype), m_items(nsize), m_sync_wait(false)
 {
-	m_nsize = (4 << 1);
-	while (m_nsize < nsize)
-		m_nsize <<= 1;
-	m_nmask = (m_nsize - 1);
-	m_items = new int [m_nsize];
-
-	m_iread  = 0;
-	m_iwrite = 0;
+	m_nbatch = m_items.size();
+	m_batch = new int [m_nbatch];
+
+	QMutexLocker locker(&g_sched_mutex);
+
+	if (++g_sched_refcount == 1 && g_sched_pool == nullptr)
+		g_sched_pool = new samplv1_sched_pool();
+
+	samplv1_sched_instance *inst = g_sched_instances.value(m_pSampl, nullptr);
+	if (inst == nullptr) {
+		inst = new samplv1_sched_instance;
+		inst->refcount = 0;
+		samplv1_sched_excl *excl = new samplv1_sched_excl();
+		inst->lanes[samplv1_sched_lane::Fast]
+			= new samplv1_sched_lane(samplv1_sched_lane::Fast, excl);
+		inst->lanes[samplv1_sched_lane::Slow]
+			= new samplv1_sched_lane(samplv1_sched_lane::Slow, excl);
+		g_sched_instances.insert(m_pSampl, inst);
+	}
 
-	::memset(m_items, 0, m_nsize * sizeof(int));
+	++inst->refcount;
 
-	if (++g_sched_refcount == 1 && g_sched_thread == nullptr) {
-		g_sched_thread = new samplv1_sched_thread();
-		g_sched_thread->start();
-	}
+	m_lane = inst->lanes[samplv1_sched_lane::lane(m_stype)];
 }
 
 
 // dtor (virtual).
 samplv1_sched::~samplv1_sched (void)
 {
-	delete [] m_items;
+	QMutexLocker locker(&g_sched_mutex);
+
+	m_lane->cancel(this);
+
+	delete [] m_batch;
+
+	samplv1_sched_instance *inst = g_sched_instances.value(m_pSampl, nullptr);
+	if (inst && --inst->refcount == 0) {
+		g_sched_instances.remove(m_pSampl);
+		inst->lanes[samplv1_sched_lane::Fast]->close();
+		inst->lanes[samplv1_sched_lane::Slow]->close();
+		delete inst;
+	}
 
 	if (--g_sched_refcount == 0) {
-		if (g_sched_thread) {
-			delete g_sched_thread;
-			g_sched_thread = nullptr;
+		if (g_sched_pool) {
+			delete g_sched_pool;
+			g_sched_pool = nullptr;
 		}
 	}
 }
@@ -249,75 +910,182 @@ samplv1 *samplv1_sched::instance (void) const
 }
 
 
+// sched type accessor.
+samplv1_sched::Type samplv1_sched::stype (void) const
+{
+	return m_stype;
+}
+
+
 // schedule process.
 void samplv1_sched::schedule ( int sid )
 {
-	const uint32_t w = (m_iwrite + 1) & m_nmask;
-	if (w != m_iread) {
-		m_items[m_iwrite] = sid;
-		m_iwrite = w;
-	}
+	if (!m_items.push(sid))
+		++g_sched_overflows;
 
-	if (g_sched_thread)
-		g_sched_thread->schedule(this);
+	m_lane->schedule(this);
 }
 
 
 // test-and-set.
 bool samplv1_sched::sync_wait (void)
 {
-	const bool sync_wait = m_sync_wait;
+	return m_sync_wait.exchange(true, std::memory_order_acq_rel);
+}
 
-	if (!sync_wait)
-		m_sync_wait = true;
 
-	return sync_wait;
+// test-and-clear.
+void samplv1_sched::sync_done (void)
+{
+	m_sync_wait.exchange(false, std::memory_order_acq_rel);
 }
 
 
 // scheduled processor.
 void samplv1_sched::sync_process (void)
 {
-	// do whatever we must...
-	uint32_t r = m_iread;
-	while (r != m_iwrite) {
-		const int sid = m_items[r];
-		process(sid);
-		sync_notify(m_pSampl, m_stype, sid);
-		m_items[r] = 0;
-		r = (r + 1) & m_nmask;
+	// clear first, so that any late schedule gets queued again.
+	sync_done();
+
+	// drain pending ids, coalescing duplicates (latest wins)...
+	uint32_t n = 0;
+	int sid = 0;
+	for (;;) {
+		if (n < m_nbatch && m_items.pop(sid)) {
+			uint32_t i = 0;
+			while (i < n && m_batch[i] != sid)
+				++i;
+			if (i < n) {
+				// move it to the back (latest).
+				for (++i; i < n; ++i)
+					m_batch[i - 1] = m_batch[i];
+				m_batch[n - 1] = sid;
+			}
+			else m_batch[n++] = sid;
+			continue;
+		}
+		// do whatever we must...
+		for (uint32_t i = 0; i < n; ++i) {
+			process(m_batch[i]);
+			sync_notify(m_pSampl, m_stype, m_batch[i]);
+		}
+		if (n < m_nbatch)
+			break;
+		n = 0;
 	}
-	m_iread = r;
-
-	m_sync_wait = false;
 }
 
 
 // signal broadcast (static).
 void samplv1_sched::sync_notify ( samplv1 *pSampl, Type stype, int sid )
 {
-	if (g_sched_notifiers.contains(pSampl)) {
-		const QList<Notifier *>& list
-			= g_sched_notifiers.value(pSampl);
-		QListIterator<Notifier *> iter(list);
-		while (iter.hasNext())
-			iter.next()->notify(stype, sid);
+	const uint32_t e = samplv1_sched_notifiers_enter();
+	++g_sched_notifiers_depth;
+
+	const samplv1_sched_notifiers *notifiers = g_sched_notifiers.load();
+	if (notifiers) {
+		QListIterator<samplv1_sched_notifiers::Item> iter(notifiers->items);
+		while (iter.hasNext()) {
+			const samplv1_sched_notifiers::Item& item = iter.next();
+			if (item.pSampl == pSampl) {
+				QListIterator<Notifier *> iter2(item.list);
+				while (iter2.hasNext())
+					iter2.next()->notify(stype, sid);
+				break;
+			}
+		}
 	}
+
+	--g_sched_notifiers_depth;
+	samplv1_sched_notifiers_leave(e);
 }
 
 
 // process/clear pending schedules, immediately. (static)
-void samplv1_sched::sync_pending (void)
+void samplv1_sched::sync_pending ( samplv1 *pSampl )
 {
-	if (g_sched_thread)
-		g_sched_thread->sync_pending();
+	QMutexLocker locker(&g_sched_mutex);
+
+	QHashIterator<samplv1 *, samplv1_sched_instance *> iter(g_sched_instances);
+	while (iter.hasNext()) {
+		iter.next();
+		if (pSampl == nullptr || pSampl == iter.key()) {
+			samplv1_sched_instance *inst = iter.value();
+			inst->lanes[samplv1_sched_lane::Fast]->sync_pending();
+			inst->lanes[samplv1_sched_lane::Slow]->sync_pending();
+		}
+	}
+}
+
+
+void samplv1_sched::sync_reset ( samplv1 *pSampl )
+{
+	QMutexLocker locker(&g_sched_mutex);
+
+	QHashIterator<samplv1 *, samplv1_sched_instance *> iter(g_sched_instances);
+	while (iter.hasNext()) {
+		iter.next();
+		if (pSampl == nullptr || pSampl == iter.key()) {
+			samplv1_sched_instance *inst = iter.value();
+			inst->lanes[samplv1_sched_lane::Fast]->sync_reset();
+			inst->lanes[samplv1_sched_lane::Slow]->sync_reset();
+		}
+	}
+}
+
+
+// queue statistics. (static)
+uint32_t samplv1_sched::overflows (void)
+{
+	return g_sched_overflows.load();
+}
+
+
+uint32_t samplv1_sched::latency_max (void)
+{
+	return uint32_t(g_sched_latency_max.load() / 1000);
+}
+
+
+uint32_t samplv1_sched::latency_avg (void)
+{
+	const uint32_t count = g_sched_latency_count.load();
+	return (count > 0 ? uint32_t(g_sched_latency_sum.load() / count / 1000) : 0);
+}
+
+
+void samplv1_sched::latency_histogram ( Type stype, uint32_t *counts )
+{
+	for (uint32_t i = 0; i < HISTOGRAM_SIZE; ++i)
+		counts[i] = g_sched_latency_histogram[stype][i].load();
 }
 
 
-void samplv1_sched::sync_reset (void)
+// real-time helper deadline misses (real-time safe).
+void samplv1_sched::deadline_miss (void)
 {
-	if (g_sched_thread)
-		g_sched_thread->sync_reset();
+	g_sched_deadline_misses.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+uint32_t samplv1_sched::deadline_misses (void)
+{
+	return g_sched_deadline_misses.load();
+}
+
+
+void samplv1_sched::reset_stats (void)
+{
+	g_sched_overflows = 0;
+	g_sched_deadline_misses = 0;
+	g_sched_latency_max = 0;
+	g_sched_latency_sum = 0;
+	g_sched_latency_count = 0;
+
+	for (uint32_t t = 0; t < NUM_TYPES; ++t) {
+		for (uint32_t i = 0; i < HISTOGRAM_SIZE; ++i)
+			g_sched_latency_histogram[t][i] = 0;
+	}
 }
 
 
@@ -327,20 +1095,33 @@ void samplv1_sched::sync_reset (void)
 
 // ctor.
 samplv1_sched::Notifier::Notifier ( samplv1 *pSampl )
-	: m_pSampl(pSampl)
+	: m_pSampl(pSampl), m_attached(false)
 {
-	g_sched_notifiers[pSampl].append(this);
 }
 
 
 // dtor.
 samplv1_sched::Notifier::~Notifier (void)
 {
-	if (g_sched_notifiers.contains(m_pSampl)) {
-		QList<Notifier *>& list = g_sched_notifiers[m_pSampl];
-		list.removeAll(this);
-		if (list.isEmpty())
-			g_sched_notifiers.remove(m_pSampl);
+	detach();
+}
+
+
+// (un)register.
+void samplv1_sched::Notifier::attach (void)
+{
+	if (!m_attached) {
+		samplv1_sched_notifiers_update(m_pSampl, this, true);
+		m_attached = true;
+	}
+}
+
+
+void samplv1_sched::Notifier::detach (void)
+{
+	if (m_attached) {
+		samplv1_sched_notifiers_update(m_pSampl, this, false);
+		m_attached = false;
 	}
 }
 
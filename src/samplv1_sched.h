@@ -24,9 +24,125 @@
 
 #include <cstdint>
 
+#include <atomic>
+
 
 // forward decls.
 class samplv1;
+class samplv1_sched_lane;
+
+
+//-------------------------------------------------------------------------
+// samplv1_sched_queue - bounded lock-free queue (multi-producer,
+// multi-consumer; after D.Vyukov's bounded queue).
+//
+
+template <typename T>
+class samplv1_sched_queue
+{
+public:
+
+	// ctor.
+	samplv1_sched_queue(uint32_t nsize = 8)
+	{
+		m_nsize = (4 << 1);
+		while (m_nsize < nsize)
+			m_nsize <<= 1;
+		m_nmask = (m_nsize - 1);
+		m_items = new Item [m_nsize];
+
+		for (uint32_t i = 0; i < m_nsize; ++i)
+			m_items[i].seq.store(i, std::memory_order_relaxed);
+
+		m_iread.store(0, std::memory_order_relaxed);
+		m_iwrite.store(0, std::memory_order_relaxed);
+	}
+
+	// dtor.
+	~samplv1_sched_queue()
+		{ delete [] m_items; }
+
+	// push (any thread); false when full.
+	bool push(const T& data)
+	{
+		Item *item;
+		uint32_t w = m_iwrite.load(std::memory_order_relaxed);
+		for (;;) {
+			item = &m_items[w & m_nmask];
+			const uint32_t seq = item->seq.load(std::memory_order_acquire);
+			const int32_t dif = int32_t(seq - w);
+			if (dif == 0) {
+				if (m_iwrite.compare_exchange_weak(w, w + 1,
+						std::memory_order_relaxed))
+					break;
+			}
+			else
+			if (dif < 0)
+				return false;
+			else
+				w = m_iwrite.load(std::memory_order_relaxed);
+		}
+		item->data = data;
+		item->seq.store(w + 1, std::memory_order_release);
+		return true;
+	}
+
+	// pop (any thread); false when empty.
+	bool pop(T& data)
+	{
+		Item *item;
+		uint32_t r = m_iread.load(std::memory_order_relaxed);
+		for (;;) {
+			item = &m_items[r & m_nmask];
+			const uint32_t seq = item->seq.load(std::memory_order_acquire);
+			const int32_t dif = int32_t(seq - (r + 1));
+			if (dif == 0) {
+				if (m_iread.compare_exchange_weak(r, r + 1,
+						std::memory_order_relaxed))
+					break;
+			}
+			else
+			if (dif < 0)
+				return false;
+			else
+				r = m_iread.load(std::memory_order_relaxed);
+		}
+		data = item->data;
+		item->seq.store(r + m_nsize, std::memory_order_release);
+		return true;
+	}
+
+	// capacity.
+	uint32_t size() const
+		{ return m_nsize; }
+
+	// whether it's empty (approximate, when contended).
+	bool empty() const
+	{
+		const uint32_t r = m_iread.load(std::memory_order_relaxed);
+		const Item *item = &m_items[r & m_nmask];
+		const uint32_t seq = item->seq.load(std::memory_order_acquire);
+		return (int32_t(seq - (r + 1)) < 0);
+	}
+
+private:
+
+	// queue slot.
+	struct Item
+	{
+		std::atomic<uint32_t> seq;
+		T data;
+	};
+
+	// instance variables.
+	uint32_t m_nsize;
+	uint32_t m_nmask;
+
+	Item *m_items;
+
+	std::atomic<uint32_t> m_iread;
+	std::atomic<uint32_t> m_iwrite;
+};
 
 
 //-------------------------------------------------------------------------
@@ -38,7 +154,9 @@ class samplv1_sched
 public:
 
 	// plausible sched types.
-	enum Type { Sample, Programs, Controls, Controller, MidiIn };
+	enum Type { Sample, Programs, Controls, Controller, MidiIn, Effects };
+
+	static const uint32_t NUM_TYPES = Effects + 1;
 
 	// ctor.
 	samplv1_sched(samplv1 *pSampl, Type stype, uint32_t nsize = 8);
@@ -49,12 +167,18 @@ public:
 	// instance access.
 	samplv1 *instance() const;
 
+	// sched type accessor.
+	Type stype() const;
+
 	// schedule process.
 	void schedule(int sid = 0);
 
 	// test-and-set wait.
 	bool sync_wait();
-	
+
+	// test-and-clear wait.
+	void sync_done();
+
 	// scheduled processor.
 	void sync_process();
 
@@ -79,15 +203,41 @@ public:
 		// signal notifier.
 		virtual void notify(samplv1_sched::Type stype, int sid) const = 0;
 
+		// (un)register, once fully constructed (or before
+		// being destroyed), as notify() may be called anytime
+		// from any other thread in-between.
+		void attach();
+		void detach();
+
 	private:
 
 		// instance variables.
 		samplv1 *m_pSampl;
+
+		bool m_attached;
 	};
 
 	// process/clear pending schedules, immediately. (static)
-	static void sync_pending();
-	static void sync_reset();
+	// (all instances, when none given)
+	static void sync_pending(samplv1 *pSampl = nullptr);
+	static void sync_reset(samplv1 *pSampl = nullptr);
+
+	// queue statistics. (static)
+	static uint32_t overflows();
+	static uint32_t latency_max(); // usecs
+	static uint32_t latency_avg(); // usecs
+
+	// per-type latency histograms, in HISTOGRAM_SIZE
+	// buckets: [0] < 1us, [i] < 2^i us (last one open).
+	static const uint32_t HISTOGRAM_SIZE = 16;
+
+	static void latency_histogram(Type stype, uint32_t *counts);
+
+	// real-time helper deadline misses (eg. reverb tail blocks).
+	static void deadline_miss();
+	static uint32_t deadline_misses();
+
+	static void reset_stats();
 
 private:
 
@@ -97,15 +247,16 @@ private:
 	Type m_stype;
 
 	// sched queue instance reference.
-	uint32_t m_nsize;
-	uint32_t m_nmask;
+	samplv1_sched_queue<int> m_items;
 
-	int *m_items;
+	// pending ids, coalesced.
+	uint32_t m_nbatch;
+	int *m_batch;
 
-	volatile uint32_t m_iread;
-	volatile uint32_t m_iwrite;
+	// per-instance (worker) queue lane.
+	samplv1_sched_lane *m_lane;
 
-	volatile bool m_sync_wait;
+	std::atomic<bool> m_sync_wait;
 };
 
 
@@ -0,0 +1,110 @@
+// samplv1_sem.h
+//
+/****************************************************************************
+   Copyright (C) 2012-2024, rncbc aka Rui Nuno Capela. All rights reserved.
+
+   This program is free software; you can redistribute it and/or
+   modify it under the terms of the GNU General Public License
+   as published by the Free Software Foundation; either version 2
+   of the License, or (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License along
+   with this program; if not, write to the Free Software Foundation, Inc.,
+   51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+
+*****************************************************************************/
+
+#ifndef __samplv1_sem_h
+#define __samplv1_sem_h
+
+#include <cstdint>
+
+#include <atomic>
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#else
+#include <QSemaphore>
+#endif
+
+
+//-------------------------------------------------------------------------
+// samplv1_sem - counting semaphore, with a real-time safe post().
+//
+// post() never blocks nor takes any lock: it's an atomic increment,
+// plus a futex wake-up syscall only when there's someone waiting.
+// (falls back to QSemaphore where futexes are not available.)
+//
+
+class samplv1_sem
+{
+public:
+
+	// ctor.
+	samplv1_sem() : m_count(0), m_waiters(0) {}
+
+	// signal (any thread; real-time safe).
+	void post(uint32_t n = 1)
+	{
+	#if defined(__linux__)
+		m_count.fetch_add(n, std::memory_order_seq_cst);
+		if (m_waiters.load(std::memory_order_seq_cst) > 0)
+			futex(FUTEX_WAKE_PRIVATE, int(n));
+	#else
+		m_sem.release(int(n));
+	#endif
+	}
+
+	// wait for a signal (non-real-time).
+	void wait()
+	{
+	#if defined(__linux__)
+		for (;;) {
+			uint32_t count = m_count.load(std::memory_order_acquire);
+			while (count > 0) {
+				if (m_count.compare_exchange_weak(count, count - 1,
+						std::memory_order_acquire))
+					return;
+			}
+			m_waiters.fetch_add(1, std::memory_order_seq_cst);
+			if (m_count.load(std::memory_order_seq_cst) == 0)
+				futex(FUTEX_WAIT_PRIVATE, 0);
+			m_waiters.fetch_sub(1, std::memory_order_relaxed);
+		}
+	#else
+		m_sem.acquire();
+	#endif
+	}
+
+protected:
+
+#if defined(__linux__)
+	void futex(int op, int val)
+	{
+		::syscall(SYS_futex, reinterpret_cast<uint32_t *> (&m_count),
+			op, val, nullptr, nullptr, 0);
+	}
+#endif
+
+private:
+
+	// instance variables.
+	std::atomic<uint32_t> m_count;
+	std::atomic<uint32_t> m_waiters;
+
+#if !defined(__linux__)
+	QSemaphore m_sem;
+#endif
+};
+
+
+#endif	// __samplv1_sem_h
+
+// end of samplv1_sem.h
@@ -302,6 +302,18 @@ void samplv1_ui::resetTuning (void)
 }
 
 
+// Convolution reverb impulse response file.
+void samplv1_ui::setReverbFile ( const char *pszReverbFile )
+{
+	m_pSampl->setReverbFile(pszReverbFile);
+}
+
+const char *samplv1_ui::reverbFile (void) const
+{
+	return m_pSampl->reverbFile();
+}
+
+
 // MIDI note/octave name helper (static).
 QString samplv1_ui::noteName ( int note )
 {
@@ -112,6 +112,9 @@ public:
 
 	void resetTuning();
 
+	void setReverbFile(const char *pszReverbFile);
+	const char *reverbFile() const;
+
 	// MIDI note/octave name helper.
 	static QString noteName(int note);
 
@@ -36,6 +36,7 @@
 #include "ui_samplv1widget.h"
 
 #include <QMessageBox>
+#include <QFileDialog>
 #include <QDir>
 #include <QTimer>
 
@@ -600,6 +601,11 @@ samplv1widget::samplv1widget ( QWidget *pParent )
 		SIGNAL(customContextMenuRequested(const QPoint&)),
 		SLOT(spinboxContextMenu(const QPoint&)));
 
+	// Reverb impulse response...
+	QObject::connect(m_ui.Rev1ImpulseButton,
+		SIGNAL(clicked()),
+		SLOT(rev1ImpulseClicked()));
+
 	// Randomize params...
 	QObject::connect(m_ui.RandomParamsButton,
 		SIGNAL(clicked()),
@@ -1042,6 +1048,7 @@ void samplv1widget::updateParamValues (void)
 	}
 
 	updateSample(pSamplUi->sample());
+	updateReverbFile();
 }
 
 
@@ -1293,6 +1300,82 @@ void samplv1widget::playSample (void)
 }
 
 
+// Convolution reverb impulse response (open or clear).
+void samplv1widget::rev1ImpulseClicked (void)
+{
+	samplv1_ui *pSamplUi = ui_instance();
+	if (pSamplUi == nullptr)
+		return;
+
+	if (pSamplUi->reverbFile()) {
+		pSamplUi->setReverbFile(nullptr);
+		m_ui.StatusBar->showMessage(tr("Clear impulse response"), 5000);
+		updateReverbFile();
+		updateDirtyPreset(true);
+		return;
+	}
+
+	samplv1_config *pConfig = samplv1_config::getInstance();
+	if (pConfig == nullptr) {
+		updateReverbFile();
+		return;
+	}
+
+	QStringList filters;
+	filters.append(tr("Audio files (%1)")
+		.arg("*.wav *.flac *.aif *.aiff *.ogg *.caf *.w64"));
+	filters.append(tr("All files (*.*)"));
+
+	const QString& sTitle  = tr("Open Impulse Response");
+	const QString& sFilter = filters.join(";;");
+	QWidget *pParentWidget = nullptr;
+	QFileDialog::Options options;
+	if (pConfig->bDontUseNativeDialogs) {
+		options |= QFileDialog::DontUseNativeDialog;
+		pParentWidget = QWidget::window();
+	}
+
+	const QString& sFilename = QFileDialog::getOpenFileName(pParentWidget,
+		sTitle, pConfig->sSampleDir, sFilter, nullptr, options);
+
+	if (!sFilename.isEmpty()) {
+		const QFileInfo info(sFilename);
+		const QString& sReverbFile = info.canonicalFilePath();
+		pSamplUi->setReverbFile(sReverbFile.toUtf8().constData());
+		if (pSamplUi->reverbFile()) {
+			m_ui.StatusBar->showMessage(
+				tr("Load impulse response: %1").arg(sReverbFile), 5000);
+			updateDirtyPreset(true);
+		} else {
+			QMessageBox::warning(this, tr("Warning"),
+				tr("Could not load impulse response from file:\n\n"
+				"\"%1\"\n\nSorry.").arg(sFilename),
+				QMessageBox::Ok);
+		}
+	}
+
+	updateReverbFile();
+}
+
+
+// Convolution reverb impulse response updater.
+void samplv1widget::updateReverbFile (void)
+{
+	samplv1_ui *pSamplUi = ui_instance();
+	const char *pszReverbFile
+		= (pSamplUi ? pSamplUi->reverbFile() : nullptr);
+
+	m_ui.Rev1ImpulseButton->setChecked(pszReverbFile != nullptr);
+
+	if (pszReverbFile) {
+		m_ui.Rev1ImpulseButton->setToolTip(tr("Reverb Impulse Response: %1")
+			.arg(QFileInfo(QString::fromUtf8(pszReverbFile)).fileName()));
+	} else {
+		m_ui.Rev1ImpulseButton->setToolTip(tr("Reverb Impulse Response"));
+	}
+}
+
+
 // Dirty close prompt,
 bool samplv1widget::queryClose (void)
 {
@@ -111,6 +111,9 @@ protected slots:
 	// Sample playback (direct note-on/off).
 	void playSample(void);
 
+	// Convolution reverb impulse response slot.
+	void rev1ImpulseClicked();
+
 	// Common context menu.
 	void contextMenuRequest(const QPoint& pos);
 
@@ -196,6 +199,9 @@ protected:
 	// Update offset/loop range change status.
 	void updateOffsetLoop(samplv1_sample *pSample, bool bDirty = false);
 
+	// Convolution reverb impulse response updater.
+	void updateReverbFile();
+
 	// Param port methods.
 	virtual void updateParam(samplv1::ParamIndex index, float fValue) const = 0;
 
@@ -261,7 +267,10 @@ protected:
 	public:
 
 		Notifier(samplv1 *pSampl, samplv1widget_sched *pSched)
-			: samplv1_sched::Notifier(pSampl), m_pSched(pSched) {}
+			: samplv1_sched::Notifier(pSampl), m_pSched(pSched) { attach(); }
+
+		~Notifier()
+			{ detach(); }
 
 		void notify(samplv1_sched::Type stype, int sid) const
 			{ m_pSched->emit_notify(stype, sid); }
@@ -740,6 +740,7 @@ void samplv1widget_controls::loadControls ( samplv1_controls *pControls )
 
 void samplv1widget_controls::saveControls ( samplv1_controls *pControls )
 {
+	pControls->begin_update();
 	pControls->clear();
 
 	const int iItemCount = QTreeWidget::topLevelItemCount();
@@ -757,6 +758,8 @@ void samplv1widget_controls::saveControls ( samplv1_controls *pControls )
 		data.flags = pItem->data(3, Qt::UserRole + 1).toInt();
 		pControls->add_control(key, data);
 	}
+
+	pControls->end_update();
 }
 
 
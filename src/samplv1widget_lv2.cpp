@@ -196,7 +196,9 @@ void samplv1widget_lv2::closeEvent ( QCloseEvent *pCloseEvent )
 void samplv1widget_lv2::port_event ( uint32_t port_index,
 	uint32_t buffer_size, uint32_t format, const void *buffer )
 {
-	if (format == 0 && buffer_size == sizeof(float)) {
+	if (format == 0 && buffer_size == sizeof(float)
+		&& port_index >= samplv1_lv2::ParamBase
+		&& port_index <  samplv1_lv2::Latency) {
 		const samplv1::ParamIndex index
 			= samplv1::ParamIndex(port_index - samplv1_lv2::ParamBase);
 		const float fValue = *(float *) buffer;